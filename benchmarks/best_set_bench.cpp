@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <dferone/containers/BestSet.h>
+#include <dferone/containers/HeapBestSet.h>
+#include <random>
+#include <vector>
+
+namespace {
+    using namespace dferone::containers;
+
+    /// Costs of a stream of GRASP iterations: slowly improving, with noise, so that a fraction of them enters the pool
+    std::vector<double> costs(std::size_t n) {
+        std::mt19937_64 rng(0);
+        std::normal_distribution<double> noise(0.0, 100.0);
+        std::vector<double> ret(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ret[i] = 1000.0 - 0.01 * static_cast<double>(i) + noise(rng);
+        }
+        return ret;
+    }
+
+    template<class Set>
+    void add_stream(benchmark::State &state) {
+        auto capacity = static_cast<std::size_t>(state.range(0));
+        auto stream = costs(1 << 16);
+        for (auto _ : state) {
+            Set set(capacity);
+            for (auto cost : stream) {
+                set.add(cost);
+            }
+            benchmark::DoNotOptimize(set.top());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(stream.size()));
+    }
+
+    void BM_BestSetAdd(benchmark::State &state) { add_stream<BestSet<double, std::less<>>>(state); }
+
+    void BM_HeapBestSetAdd(benchmark::State &state) { add_stream<HeapBestSet<double, std::less<>>>(state); }
+
+    void BM_HeapBestSetMerge(benchmark::State &state) {
+        auto capacity = static_cast<std::size_t>(state.range(0));
+        auto stream = costs(2 * capacity);
+        HeapBestSet<double, std::less<>> first(capacity);
+        HeapBestSet<double, std::less<>> second(capacity);
+        for (std::size_t i = 0; i < stream.size(); ++i) {
+            (i % 2 == 0 ? first : second).add(stream[i]);
+        }
+        for (auto _ : state) {
+            auto merged = first;
+            merged.merge(second);
+            benchmark::DoNotOptimize(merged.top());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(capacity));
+    }
+} // namespace
+
+BENCHMARK(BM_BestSetAdd)->Arg(100)->Arg(500)->Arg(2000);
+BENCHMARK(BM_HeapBestSetAdd)->Arg(100)->Arg(500)->Arg(2000);
+BENCHMARK(BM_HeapBestSetMerge)->Arg(500)->Arg(2000);
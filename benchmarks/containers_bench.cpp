@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <dferone/containers/FiniteSet.h>
+#include <dferone/containers/SoterdVector.h>
+#include <dferone/random.h>
+#include <vector>
+
+namespace {
+    using namespace dferone::containers;
+    using dferone::random::Xoshiro256StarStar;
+
+    std::vector<std::uint32_t> random_elements(std::size_t n, std::size_t count) {
+        Xoshiro256StarStar rng(0);
+        std::vector<std::uint32_t> elements(count);
+        for (auto &element : elements) {
+            element = static_cast<std::uint32_t>(dferone::random::bounded_rand(rng, n));
+        }
+        return elements;
+    }
+
+    void BM_FiniteSetAddRemove(benchmark::State &state) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        FiniteSet<std::uint32_t> fs(n);
+        auto elements = random_elements(n, 1 << 12);
+        for (auto _ : state) {
+            for (auto element : elements) {
+                fs.add(element);
+            }
+            for (auto element : elements) {
+                fs.remove(element);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * 2 * static_cast<std::int64_t>(elements.size()));
+    }
+
+    void BM_FiniteSetContains(benchmark::State &state) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        FiniteSet<std::uint32_t> fs(n, n / 2);
+        auto elements = random_elements(n, 1 << 12);
+        for (auto _ : state) {
+            std::size_t found = 0;
+            for (auto element : elements) {
+                found += fs.contains(element);
+            }
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(elements.size()));
+    }
+
+    /// Copy of a set with few elements into a set of the same capacity
+    void BM_FiniteSetCopy(benchmark::State &state) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        FiniteSet<std::uint32_t> source(n, random_elements(n, 16));
+        FiniteSet<std::uint32_t> target(n);
+        for (auto _ : state) {
+            target = source;
+            benchmark::DoNotOptimize(target.size());
+        }
+    }
+
+    void BM_FiniteSetSample(benchmark::State &state) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        FiniteSet<std::uint32_t> fs(n, n);
+        Xoshiro256StarStar rng(0);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(fs.sample(16, rng).data());
+        }
+    }
+
+    void BM_SortedVectorAdd(benchmark::State &state) {
+        auto elements = random_elements(1u << 30, static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            SortedVector<std::uint32_t> sv;
+            for (auto element : elements) {
+                sv.add(element);
+            }
+            benchmark::DoNotOptimize(sv.size());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(elements.size()));
+    }
+
+    void BM_SortedVectorInsertRange(benchmark::State &state) {
+        auto elements = random_elements(1u << 30, static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            SortedVector<std::uint32_t> sv;
+            sv.insert_range(elements);
+            benchmark::DoNotOptimize(sv.size());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(elements.size()));
+    }
+} // namespace
+
+BENCHMARK(BM_FiniteSetAddRemove)->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK(BM_FiniteSetContains)->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK(BM_FiniteSetCopy)->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK(BM_FiniteSetSample)->Arg(1 << 8)->Arg(1 << 16);
+BENCHMARK(BM_SortedVectorAdd)->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 15);
+BENCHMARK(BM_SortedVectorInsertRange)->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 15);
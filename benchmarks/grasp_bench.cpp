@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <dferone/algorithms/GRASP.h>
+#include <dferone/random.h>
+#include <memory>
+#include <thread>
+
+namespace {
+    using namespace dferone::algorithms;
+    using dferone::random::Xoshiro256StarStar;
+
+    struct Instance {
+        /// Random numbers drawn by a construction, and by a local search
+        std::size_t work{2000};
+    };
+
+    struct Solution {
+        explicit Solution(const Instance &, double cost = std::numeric_limits<double>::max()) : cost_(cost) {}
+
+        [[nodiscard]] double getCost() const { return cost_; }
+
+        double cost_;
+    };
+
+    /// Synthetic constructor: the cost is the minimum of many random draws
+    struct Construct {
+        Solution createSolution(const Instance &instance, Xoshiro256StarStar &rng) {
+            double cost = std::numeric_limits<double>::max();
+            for (std::size_t i = 0; i < instance.work; ++i) {
+                cost = std::min(cost, dferone::random::unit_double(rng) * 1000.0);
+            }
+            return Solution(instance, cost);
+        }
+    };
+
+    /// Synthetic local search: halves the cost after the same amount of work
+    struct Improve {
+        void search(Solution &s, Xoshiro256StarStar &rng) {
+            double noise = 0.0;
+            for (std::size_t i = 0; i < work; ++i) {
+                noise += dferone::random::unit_double(rng);
+            }
+            s.cost_ = s.cost_ / 2.0 + noise * 1e-9;
+        }
+
+        std::size_t work;
+    };
+
+    /// The same components behind the virtual interfaces
+    struct Constructor : public SolutionConstructor<Instance, Solution, Xoshiro256StarStar> {
+        Solution createSolution(const Instance &instance, Xoshiro256StarStar &rng) override { return Construct{}.createSolution(instance, rng); }
+
+        [[nodiscard]] std::unique_ptr<SolutionConstructor<Instance, Solution, Xoshiro256StarStar>> clone() const override {
+            return std::make_unique<Constructor>();
+        }
+    };
+
+    struct Search : public LocalSearch<Solution, Xoshiro256StarStar> {
+        explicit Search(std::size_t work) : improve_{work} {}
+
+        void search(Solution &s, Xoshiro256StarStar &rng) override { improve_.search(s, rng); }
+
+        [[nodiscard]] std::unique_ptr<LocalSearch<Solution, Xoshiro256StarStar>> clone() const override { return std::make_unique<Search>(improve_.work); }
+
+        Improve improve_;
+    };
+
+    /// Fixed number of iterations, shared by range(0) threads
+    void BM_GraspScaling(benchmark::State &state) {
+        constexpr std::size_t iterations = 4096;
+        auto threads = static_cast<std::uint32_t>(state.range(0));
+        Instance instance;
+        GRASP<Instance, Solution, Xoshiro256StarStar> grasp(instance, 0);
+        grasp.setVerbose(false);
+        grasp.addSolutionConstructor(std::make_unique<Constructor>());
+        grasp.addLocalSearch(std::make_unique<Search>(instance.work));
+        grasp.bindThreadPool(std::make_shared<ThreadPool>(threads));
+        grasp.setMaxIterations(iterations);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(grasp.solve(threads).getCost());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(iterations));
+    }
+
+    /// Micro-instances, where the overhead of an iteration is comparable to its work: virtual components
+    void BM_GraspIterationVirtual(benchmark::State &state) {
+        constexpr std::size_t iterations = 1 << 14;
+        Instance instance{static_cast<std::size_t>(state.range(0))};
+        GRASP<Instance, Solution, Xoshiro256StarStar> grasp(instance, 0);
+        grasp.setVerbose(false);
+        grasp.addSolutionConstructor(std::make_unique<Constructor>());
+        grasp.addLocalSearch(std::make_unique<Search>(instance.work));
+        grasp.bindThreadPool(std::make_shared<ThreadPool>(1));
+        grasp.setMaxIterations(iterations);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(grasp.solve(1).getCost());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(iterations));
+    }
+
+    /// The same, with the components as policies of BasicGRASP
+    void BM_GraspIterationStatic(benchmark::State &state) {
+        constexpr std::size_t iterations = 1 << 14;
+        Instance instance{static_cast<std::size_t>(state.range(0))};
+        BasicGRASP<Instance, Solution, Construct, Improve, NoVisitor, Xoshiro256StarStar> grasp(instance, 0, Construct{}, Improve{instance.work});
+        grasp.setVerbose(false);
+        grasp.bindThreadPool(std::make_shared<ThreadPool>(1));
+        grasp.setMaxIterations(iterations);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(grasp.solve(1).getCost());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(iterations));
+    }
+} // namespace
+
+BENCHMARK(BM_GraspIterationVirtual)->Arg(1)->Arg(16)->UseRealTime();
+BENCHMARK(BM_GraspIterationStatic)->Arg(1)->Arg(16)->UseRealTime();
+BENCHMARK(BM_GraspScaling)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <dferone/containers/Matrix.h>
+#include <dferone/containers/SymmetricMatrix.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+    using namespace dferone::containers;
+
+    std::vector<std::pair<std::size_t, std::size_t>> random_cells(std::size_t n) {
+        std::mt19937_64 rng(0);
+        std::uniform_int_distribution<std::size_t> dis(0, n - 1);
+        std::vector<std::pair<std::size_t, std::size_t>> cells(1 << 16);
+        for (auto &cell : cells) {
+            cell = {dis(rng), dis(rng)};
+        }
+        return cells;
+    }
+
+    template<class M>
+    void random_access(benchmark::State &state, const M &m) {
+        auto cells = random_cells(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            double sum = 0.0;
+            for (auto [i, j] : cells) {
+                sum += m(i, j);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cells.size()));
+    }
+
+    template<class M>
+    void row_sweep(benchmark::State &state, const M &m) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state) {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    sum += m(i, j);
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n * n));
+    }
+
+    void BM_DenseRandom(benchmark::State &state) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        random_access(state, Matrix<double>(n, n, 1.0));
+    }
+
+    void BM_PackedRandom(benchmark::State &state) {
+        random_access(state, SymmetricMatrix<double>(static_cast<std::size_t>(state.range(0)), 1.0));
+    }
+
+    void BM_DenseRowSweep(benchmark::State &state) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        row_sweep(state, Matrix<double>(n, n, 1.0));
+    }
+
+    void BM_PackedRowSweep(benchmark::State &state) {
+        row_sweep(state, SymmetricMatrix<double>(static_cast<std::size_t>(state.range(0)), 1.0));
+    }
+
+    void BM_PackedRowSpanSweep(benchmark::State &state) {
+        auto n = static_cast<std::size_t>(state.range(0));
+        SymmetricMatrix<double> m(n, 1.0);
+        for (auto _ : state) {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                for (auto value : m.packed_row(i)) {
+                    sum += value;
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(m.packed_size()));
+    }
+} // namespace
+
+BENCHMARK(BM_DenseRandom)->Arg(1 << 10)->Arg(1 << 12);
+BENCHMARK(BM_PackedRandom)->Arg(1 << 10)->Arg(1 << 12);
+BENCHMARK(BM_DenseRowSweep)->Arg(1 << 10)->Arg(1 << 12);
+BENCHMARK(BM_PackedRowSweep)->Arg(1 << 10)->Arg(1 << 12);
+BENCHMARK(BM_PackedRowSpanSweep)->Arg(1 << 10)->Arg(1 << 12);
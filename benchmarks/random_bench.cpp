@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <dferone/random.h>
+#include <random>
+#include <vector>
+
+namespace {
+    using namespace dferone::random;
+
+    std::vector<double> random_weights(std::size_t n) {
+        std::mt19937_64 rng(0);
+        std::uniform_real_distribution<double> dis(0.1, 10.0);
+        std::vector<double> weights(n);
+        for (auto &weight : weights) {
+            weight = dis(rng);
+        }
+        return weights;
+    }
+
+    constexpr std::int64_t draws = 1 << 12;
+
+    template<class Rng>
+    void BM_Engine(benchmark::State &state) {
+        Rng rng(42);
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                benchmark::DoNotOptimize(rng());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    void BM_BatchFill(benchmark::State &state) {
+        Xoshiro256StarStarBatch<> batch(42);
+        std::vector<std::uint64_t> buffer(draws);
+        for (auto _ : state) {
+            batch.fill(buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    /// Bounded integers in [0, range(0)), as drawn by a constructor picking candidates
+    void BM_UniformIntDistribution(benchmark::State &state) {
+        Xoshiro256StarStar rng(42);
+        std::uniform_int_distribution<std::uint64_t> dis(0, static_cast<std::uint64_t>(state.range(0)) - 1);
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                benchmark::DoNotOptimize(dis(rng));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    void BM_BoundedRand(benchmark::State &state) {
+        Xoshiro256StarStar rng(42);
+        auto range = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                benchmark::DoNotOptimize(bounded_rand(rng, range));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    void BM_DiscreteDistributionDraw(benchmark::State &state) {
+        auto weights = random_weights(static_cast<std::size_t>(state.range(0)));
+        std::discrete_distribution<std::size_t> dis(weights.begin(), weights.end());
+        Xoshiro256StarStar rng(0);
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                benchmark::DoNotOptimize(dis(rng));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    void BM_AliasTableDraw(benchmark::State &state) {
+        AliasTable alias(random_weights(static_cast<std::size_t>(state.range(0))));
+        Xoshiro256StarStar rng(0);
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                benchmark::DoNotOptimize(alias(rng));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    void BM_FenwickDraw(benchmark::State &state) {
+        FenwickSampler fenwick(random_weights(static_cast<std::size_t>(state.range(0))));
+        Xoshiro256StarStar rng(0);
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                benchmark::DoNotOptimize(fenwick(rng));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    /// A construction step: draw a candidate, then change its score, rebuilding the distribution
+    void BM_DiscreteDistributionDrawAndUpdate(benchmark::State &state) {
+        auto weights = random_weights(static_cast<std::size_t>(state.range(0)));
+        Xoshiro256StarStar rng(0);
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                std::discrete_distribution<std::size_t> dis(weights.begin(), weights.end());
+                auto picked = dis(rng);
+                weights[picked] = 0.5 * weights[picked] + 0.1;
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+
+    void BM_FenwickDrawAndUpdate(benchmark::State &state) {
+        FenwickSampler fenwick(random_weights(static_cast<std::size_t>(state.range(0))));
+        Xoshiro256StarStar rng(0);
+        for (auto _ : state) {
+            for (std::int64_t i = 0; i < draws; ++i) {
+                auto picked = fenwick(rng);
+                fenwick.set(picked, 0.5 * fenwick.weight(picked) + 0.1);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * draws);
+    }
+} // namespace
+
+BENCHMARK(BM_Engine<std::mt19937>);
+BENCHMARK(BM_Engine<std::mt19937_64>);
+BENCHMARK(BM_Engine<SplitMix64>);
+BENCHMARK(BM_Engine<Xoshiro256StarStar>);
+#ifdef __SIZEOF_INT128__
+BENCHMARK(BM_Engine<Pcg64>);
+#endif
+BENCHMARK(BM_BatchFill);
+BENCHMARK(BM_UniformIntDistribution)->Arg(100)->Arg(1000003);
+BENCHMARK(BM_BoundedRand)->Arg(100)->Arg(1000003);
+BENCHMARK(BM_DiscreteDistributionDraw)->Arg(32)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_AliasTableDraw)->Arg(32)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_FenwickDraw)->Arg(32)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_DiscreteDistributionDrawAndUpdate)->Arg(32)->Arg(1 << 10);
+BENCHMARK(BM_FenwickDrawAndUpdate)->Arg(32)->Arg(1 << 10);
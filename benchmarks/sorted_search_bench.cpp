@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <dferone/containers/EytzingerVector.h>
+#include <dferone/containers/SoterdVector.h>
+#include <random>
+#include <vector>
+
+namespace {
+    using namespace dferone::containers;
+
+    std::vector<int> random_values(std::size_t n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int> dis(0, 1 << 30);
+        std::vector<int> values(n);
+        for (auto &value : values) {
+            value = dis(rng);
+        }
+        return values;
+    }
+
+    template<class Search>
+    void lookups(benchmark::State &state, Search search) {
+        auto queries = random_values(1 << 16, 1);
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (auto query : queries) {
+                sum += search(query);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+    }
+
+    void BM_StdLowerBound(benchmark::State &state) {
+        auto values = random_values(static_cast<std::size_t>(state.range(0)), 0);
+        std::sort(values.begin(), values.end());
+        lookups(state, [&values](int x) { return static_cast<std::size_t>(std::lower_bound(values.begin(), values.end(), x) - values.begin()); });
+    }
+
+    void BM_SortedVectorLowerBound(benchmark::State &state) {
+        SortedVector<int> sv(random_values(static_cast<std::size_t>(state.range(0)), 0));
+        lookups(state, [&sv](int x) { return static_cast<std::size_t>(sv.lower_bound(x) - sv.begin()); });
+    }
+
+    void BM_EytzingerLowerBound(benchmark::State &state) {
+        EytzingerVector<int> ev(SortedVector<int>(random_values(static_cast<std::size_t>(state.range(0)), 0)));
+        lookups(state, [&ev](int x) { return ev.lower_bound(x); });
+    }
+} // namespace
+
+BENCHMARK(BM_StdLowerBound)->Arg(1 << 10)->Arg(1 << 17)->Arg(1 << 22);
+BENCHMARK(BM_SortedVectorLowerBound)->Arg(1 << 10)->Arg(1 << 17)->Arg(1 << 22);
+BENCHMARK(BM_EytzingerLowerBound)->Arg(1 << 10)->Arg(1 << 17)->Arg(1 << 22);
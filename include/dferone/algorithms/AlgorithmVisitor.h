@@ -5,7 +5,10 @@
 #pragma once
 
 #include "AlgorithmStatus.h"
+#include <concepts>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dferone::algorithms {
@@ -37,9 +40,76 @@ namespace dferone::algorithms {
          */
         virtual void on_iteration_end(AlgorithmStatus<Solution> &alg_status) = 0;
 
+        /**
+         * Whether the visitor can be called by several threads at once.
+         *
+         * The algorithm calls a thread-safe visitor without taking its lock, so the visitor must not modify
+         * alg_status.best_solution_, nor read it, as other threads may be updating it.
+         *
+         * @return false by default
+         */
+        virtual bool is_thread_safe() const { return false; }
+
         /**
          * Virtual destructor.
          */
         virtual ~AlgorithmVisitor() = default;
     };
+
+    /**
+     * Visitor policy of BasicGRASP: the same methods of AlgorithmVisitor, without inheriting from it.
+     * A single visitor is shared by all the threads; is_thread_safe() is optional, and false if missing.
+     */
+    template<class Visitor, class Solution>
+    concept VisitorPolicy = requires(Visitor v, AlgorithmStatus<Solution> &alg_status) {
+        v.on_algorithm_start();
+        { v.on_construction_end(alg_status) } -> std::convertible_to<bool>;
+        v.on_iteration_end(alg_status);
+    };
+
+    /**
+     * Visitor policy that does nothing, whose calls are removed at compile time.
+     */
+    struct NoVisitor {
+        void on_algorithm_start() {}
+
+        template<class Solution>
+        bool on_construction_end(AlgorithmStatus<Solution> &) {
+            return true;
+        }
+
+        template<class Solution>
+        void on_iteration_end(AlgorithmStatus<Solution> &) {}
+
+        static constexpr bool is_thread_safe() { return true; }
+    };
+
+    /**
+     * Adapter of an AlgorithmVisitor to a VisitorPolicy.
+     *
+     * @tparam Solution The solution type.
+     */
+    template<class Solution>
+    class VirtualVisitor {
+    public:
+        VirtualVisitor() = default;
+
+        explicit VirtualVisitor(std::unique_ptr<AlgorithmVisitor<Solution>> &&visitor) : visitor_(std::move(visitor)) {}
+
+        void on_algorithm_start() { visitor_->on_algorithm_start(); }
+
+        bool on_construction_end(AlgorithmStatus<Solution> &alg_status) { return visitor_->on_construction_end(alg_status); }
+
+        void on_iteration_end(AlgorithmStatus<Solution> &alg_status) { visitor_->on_iteration_end(alg_status); }
+
+        bool is_thread_safe() const { return visitor_->is_thread_safe(); }
+
+        /**
+         * @return false if no visitor is wrapped
+         */
+        explicit operator bool() const noexcept { return visitor_ != nullptr; }
+
+    private:
+        std::unique_ptr<AlgorithmVisitor<Solution>> visitor_{nullptr};
+    };
 } // namespace dferone::algorithms
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../containers/ConcurrentBestSet.h"
+#include "AlgorithmVisitor.h"
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace dferone::algorithms {
+
+    /// @brief Key of a solution in an elite pool: its cost
+    struct SolutionCost {
+        template<class Solution>
+        double operator()(const Solution &s) const {
+            return s.getCost();
+        }
+    };
+
+    /// @brief Pool of the best (and, optionally, diverse) solutions, with the smallest cost first
+    template<class Solution>
+    using ElitePool = containers::ConcurrentBestSet<Solution, SolutionCost, std::less<>>;
+
+    /** @brief Visitor collecting the solutions produced at the end of every iteration into an ElitePool
+     *
+     *  The visitor is thread-safe, so the threads of GRASP insert into the pool without stalling each other:
+     *  most solutions are rejected by the atomic threshold of the pool, and the others only lock one shard.
+     *
+     *  @tparam Solution The solution type.
+     */
+    template<class Solution>
+    class EliteVisitor : public AlgorithmVisitor<Solution> {
+    public:
+        /// @param pool Pool to fill, shared with the caller to read it after (or during) the solve
+        explicit EliteVisitor(std::shared_ptr<ElitePool<Solution>> pool) : pool_(std::move(pool)) {}
+
+        void on_algorithm_start() override {}
+
+        bool on_construction_end(AlgorithmStatus<Solution> &) override { return true; }
+
+        void on_iteration_end(AlgorithmStatus<Solution> &alg_status) override { pool_->add(alg_status.new_solution_); }
+
+        bool is_thread_safe() const override { return true; }
+
+        /// @return The pool filled by the visitor
+        [[nodiscard]] const std::shared_ptr<ElitePool<Solution>> &pool() const { return pool_; }
+
+    private:
+        std::shared_ptr<ElitePool<Solution>> pool_;
+    };
+
+} // namespace dferone::algorithms
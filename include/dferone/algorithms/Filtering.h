@@ -24,6 +24,18 @@ namespace dferone::algorithms {
             wa_.addElement(x);
         }
 
+        /*! @brief Merge the elements added to another filter, e.g. by another thread
+         *
+         * @param other Filter to merge
+         */
+        void merge(const Filtering &other) { wa_.merge(other.wa_); }
+
+        /// \return The number of elements added during the warm up
+        [[nodiscard]] std::size_t getCount() const { return wa_.getCount(); }
+
+        /// \return The threshold on the number of standard deviations
+        [[nodiscard]] double getQ() const { return q_; }
+
         /// \brief Checks if the local search must be performed
         /// \param current Current solution cost
         /// \param incumbent Incumbent solution cost
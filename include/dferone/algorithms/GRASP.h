@@ -4,18 +4,55 @@
 
 #pragma once
 
+#include "../console.h"
+#include "../random.h"
 #include "AlgorithmStatus.h"
 #include "AlgorithmVisitor.h"
+#include "Filtering.h"
 #include "LocalSearch.h"
+#include "ReactiveParameter.h"
 #include "SolutionConstructor.h"
+#include "SolveHandle.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <concepts>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <random>
+#include <stdexcept>
+#include <stop_token>
 #include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace dferone::algorithms {
-    /** @brief This class models the GRASP algorithm solver
+    /// @brief How the threads of GRASP share the best solution found
+    enum class IncumbentPolicy {
+        /// A single best solution, copied under a mutex at every improvement
+        Shared,
+        /// Every thread keeps its own incumbent, publishing only its cost; incumbents are merged at the end of solve()
+        ThreadLocal
+    };
+
+    /// @brief Requirements on the solution type of GRASP
+    template<class Solution>
+    concept GraspSolution = std::copy_constructible<Solution> && std::assignable_from<Solution &, const Solution &> && requires(const Solution &s) {
+        { s.getCost() } -> std::convertible_to<double>;
+    };
+
+    /** @brief This class models the GRASP algorithm solver, with the components given as template policies
+     *
+     *  The components are called without virtual dispatch, so the compiler can inline the whole iteration, and they
+     *  are value types: every thread works on a copy of the constructor and of the local search, with no clone() on
+     *  the heap. GRASP adapts the virtual interfaces SolutionConstructor, LocalSearch and AlgorithmVisitor to this class.
      *
      *  @tparam ProblemInstance Class which represents an instance_ of the problem.
      *  @tparam Solution        Class which represents a solution.
@@ -24,83 +61,265 @@ namespace dferone::algorithms {
      *                          * Solution(const Solution&) a copy constructor. Can be the implicit default.
      *                          * void operator=(const Solution& other) an assignment operator. Can be the implicit default.
      *                          * double getCost() const, returning the cost of the solution (the smaller the better).
+     *  @tparam Constructor     A SolutionConstructorPolicy, building a solution at each iteration.
+     *  @tparam LS              A LocalSearchPolicy, improving a solution at each iteration (NoLocalSearch to skip it).
+     *  @tparam Visitor         A VisitorPolicy (NoVisitor to skip the visits).
+     *  @tparam Rng             Random engine of the threads, passed to the constructors and local searches.
+     *                          It must be constructible from a std::seed_seq.
      */
-    template<class ProblemInstance, std::copy_constructible Solution>
-        requires requires(Solution s) {
-            { s.getCost() } -> std::convertible_to<double>;
-            std::assignable_from<Solution, Solution>;
-        }
-    class GRASP {
+    template<class ProblemInstance, GraspSolution Solution, class Constructor, class LS = NoLocalSearch, class Visitor = NoVisitor,
+             std::uniform_random_bit_generator Rng = std::mt19937>
+        requires SolutionConstructorPolicy<Constructor, ProblemInstance, Solution, Rng> && LocalSearchPolicy<LS, Solution, Rng> &&
+                 VisitorPolicy<Visitor, Solution> && std::constructible_from<Rng, std::seed_seq &>
+    class BasicGRASP {
     public:
-        GRASP(const ProblemInstance &instance, unsigned int seed) : instance_(instance), generator_(seed), best_solution_(instance) {}
+        using solution_type = Solution;
 
-        /** @brief Add a Solution Costructor to construct a Solution at each GRASP iteration
+        BasicGRASP(const ProblemInstance &instance, unsigned int seed, Constructor constructor = Constructor(), LS ls = LS(), Visitor visitor = Visitor())
+            : instance_(instance), seed_(seed), generator_(seed), constructor_(std::move(constructor)), ls_(std::move(ls)), best_solution_(instance),
+              visitor_(std::move(visitor)) {}
+
+        /// @brief Sets the constructor of the solutions, copied by every thread
+        void setSolutionConstructor(Constructor constructor) {
+            constructor_ = std::move(constructor);
+            workers_.clear();
+        }
+
+        /// @brief Sets the local search, copied by every thread
+        void setLocalSearch(LS ls) {
+            ls_ = std::move(ls);
+            workers_.clear();
+        }
+
+        /// @brief Sets the visitor, shared by all the threads
+        void setVisitor(Visitor visitor) { visitor_ = std::move(visitor); }
+
+        /** @brief Runs the following solves on a pool of persistent threads
+         *
+         * The state of every thread (generator, copies of the constructor and of the local search) is kept between solves,
+         * so that a solve on the pool only pays for waking up the threads.
+         * Iterations are handed out one at a time to whichever thread is free; local searches can further split
+         * their work with a ThreadPool::TaskGroup, whose subtasks are stolen by the threads left without iterations.
          *
-         * @param constructor SolutionConstructor<ProblemInstance, Solution> pointer
+         * A solve on the pool uses at most pool->size() threads, and cannot be started from a thread of the same pool
+         * (e.g. from a local search): solve() throws std::runtime_error in both cases.
+         *
+         * @param pool The pool to use, it can be shared among several solvers (nullptr to start new threads at every solve)
          */
-        void addSolutionConstructor(std::unique_ptr<SolutionConstructor<ProblemInstance, Solution>> &&constructor) { constructor_ = std::move(constructor); }
+        void bindThreadPool(std::shared_ptr<ThreadPool> pool) { pool_ = std::move(pool); }
 
-        /** @brief Add a Local search to improve a Solution at each GRASP iteration
+        /** @brief Runs the algorithm
          *
-         * @param ls LocalSearch<Solution> pointer
+         * @param num_threads Number of threads
+         * @param stop        Token to cancel the solve: the threads stop at the end of their current iteration.
+         *                    With a token that can be stopped, no other stop condition is required.
+         * @return The best solution found
          */
-        void addLocalSearch(std::unique_ptr<LocalSearch<Solution>> &&ls) { ls_ = std::move(ls); }
-
-        Solution solve(std::uint32_t num_threads) {
-            if (!constructor_) {
+        Solution solve(std::uint32_t num_threads, std::stop_token stop = {}) {
+            if (!engaged(constructor_)) {
                 throw std::runtime_error("Cannot start GRASP without a constructor!");
             }
 
-            if (max_iterations_ == 0 && max_seconds_ == 0 && target_ <= std::numeric_limits<double>::min()) {
+            if (max_iterations_ == 0 && max_seconds_ == 0 && target_ <= std::numeric_limits<double>::min() && !stop.stop_possible()) {
                 throw std::runtime_error("Stop condition not defined!");
             }
 
-            auto old_max_iterations = max_iterations_;
-            max_iterations_ = static_cast<unsigned int>(std::ceil(static_cast<double>(max_iterations_) / num_threads));
+            if (pool_ && num_threads > pool_->size()) {
+                throw std::runtime_error("Not enough threads in the pool!");
+            }
+            if (pool_ && pool_->owns_current_thread()) {
+                throw std::runtime_error("Cannot start a solve from a thread of its own pool!");
+            }
+            stop_ = std::move(stop);
+
+            // The iteration budget is global: threads draw tickets from current_iteration_ until it is exhausted
+            current_iteration_.store(0, std::memory_order_relaxed);
+            best_cost_.store(best_solution_.getCost(), std::memory_order_relaxed);
+            ++solve_index_;
+            if (reproducible_) {
+                // The incumbent of the previous solves wins the ties against every iteration of this one
+                best_iteration_ = 0;
+                for (auto &worker : workers_) {
+                    worker.incumbent_iteration = no_iteration;
+                }
+            }
 
             start_time_ = std::chrono::high_resolution_clock::now();
 
-            if (visitor_) {
-                visitor_->on_algorithm_start();
+            if (engaged(visitor_)) {
+                visitor_.on_algorithm_start();
             }
 
             start_threads(num_threads);
 
-            max_iterations_ = old_max_iterations;
+            if (incumbent_policy_ == IncumbentPolicy::ThreadLocal) {
+                merge_incumbents();
+            }
 
             return best_solution_;
         }
 
+        /** @brief Runs the algorithm on a background thread
+         *
+         * The returned handle reads the progress of the solve, cancels it, and gives the final solution.
+         * The solver must not be used, nor destroyed, until the solve has completed.
+         *
+         * @param num_threads Number of threads
+         * @return The handle of the solve
+         */
+        SolveHandle<BasicGRASP> solve_async(std::uint32_t num_threads) {
+            std::promise<Solution> result;
+            auto future = result.get_future();
+            std::jthread thread([this, num_threads, result = std::move(result)](std::stop_token stop) mutable {
+                try {
+                    result.set_value(solve(num_threads, std::move(stop)));
+                } catch (...) {
+                    result.set_exception(std::current_exception());
+                }
+            });
+            return SolveHandle<BasicGRASP>(*this, std::move(future), std::move(thread));
+        }
+
+        /// @return The cost of the best solution found, also during a solve, without locking
+        [[nodiscard]] double getBestCost() const { return best_cost_.load(std::memory_order_acquire); }
+
+        /// @return The number of iterations started by the current (or last) solve, also during it, without locking
+        [[nodiscard]] std::size_t getIterations() const {
+            auto iterations = current_iteration_.load(std::memory_order_relaxed);
+            // Every thread draws a ticket past the budget before stopping
+            return max_iterations_ > 0 ? std::min(iterations, max_iterations_) : iterations;
+        }
+
+        /// @brief Sets the total number of iterations, shared among all the threads (0 means infinity)
         void setMaxIterations(std::size_t maxIterations) { max_iterations_ = maxIterations; }
 
         void setMaxSeconds(std::size_t maxSeconds) { max_seconds_ = maxSeconds; }
 
         void setTarget(double target) { target_ = target; }
 
-        void addVisitor(std::unique_ptr<AlgorithmVisitor<Solution>> &&visitor) { visitor_ = std::move(visitor); }
+        /// @brief Sets whether every improvement of the best solution is printed on std::cout (enabled by default)
+        void setVerbose(bool verbose) { verbose_ = verbose; }
+
+        /** @brief Enables the filtering of the local search
+         *
+         * During the first warmup_iterations local searches the improvement they bring is recorded. Afterwards, the local
+         * search is skipped whenever the constructed solution is unlikely to beat the incumbent (see Filtering).
+         * Every thread records its own statistics, which are merged at the end of solve() and kept for the following solves.
+         *
+         * @param warmup_iterations Number of local searches always performed, to estimate the improvement
+         * @param q                 Threshold on the number of standard deviations away from the mean improvement
+         */
+        void setFiltering(std::size_t warmup_iterations, double q) {
+            filtering_.emplace(q);
+            filtering_warmup_ = warmup_iterations;
+            filtering_samples_.store(0, std::memory_order_relaxed);
+        }
+
+        /** @brief Sets how the threads share the best solution
+         *
+         * With IncumbentPolicy::ThreadLocal the AlgorithmStatus passed to the visitor refers to the incumbent
+         * of the calling thread, and the global best solution is only available at the end of solve().
+         *
+         * @param policy The policy to use (IncumbentPolicy::Shared by default)
+         */
+        void setIncumbentPolicy(IncumbentPolicy policy) { incumbent_policy_ = policy; }
+
+        /** @brief Enables Reactive GRASP: the parameter of the constructor is drawn at every iteration from a set of values
+         *
+         * The probability of each value adapts to the average cost of the solutions built with it (see ReactiveParameter),
+         * and is passed to the constructor through setParameter() before the construction. The statistics are kept for
+         * the following solves. As the probabilities depend on the scheduling of the threads, the reproducible mode only
+         * holds on a single thread.
+         *
+         * @param values Values of the parameter, e.g. alpha in {0.1, 0.2, ..., 0.9}
+         * @param block  Iterations of a thread between two updates of its probabilities
+         * @param delta  Amplification of the differences among the average costs
+         */
+        void setReactive(std::vector<double> values, std::size_t block = 100, double delta = 10.0)
+            requires requires(Constructor c) { c.setParameter(0.0); }
+        {
+            reactive_.emplace(std::move(values), block, delta);
+        }
+
+        /// @return The probability of every value of the parameter in reactive mode (empty otherwise)
+        [[nodiscard]] std::vector<double> getParameterProbabilities() const {
+            if (!reactive_) {
+                return {};
+            }
+            return reactive_->probabilities(best_cost_.load(std::memory_order_acquire));
+        }
+
+        /** @brief Makes the result independent of the number of threads and of their scheduling
+         *
+         * Every iteration draws its random numbers from its own stream, derived from the seed, the number of
+         * previous solves and the index of the iteration, whichever thread runs it; solutions with the same cost
+         * are ranked by iteration. A parallel solve then returns the same solution as a single-threaded one,
+         * provided that the stop condition is the number of iterations, filtering is disabled, and constructors,
+         * local searches and visitors keep no state between iterations.
+         *
+         * A new engine is seeded at every iteration: prefer a small one with a 64-bit seed, such as
+         * random::Xoshiro256StarStar, as engines with a large state (e.g. the default std::mt19937) are seeded
+         * through a std::seed_seq filling the whole state, which can cost more than a short iteration.
+         *
+         * @param reproducible Whether to enable the reproducible mode (disabled by default)
+         */
+        void setReproducible(bool reproducible) { reproducible_ = reproducible; }
 
     private:
+        /// State owned by a single thread, kept between solves
+        struct Worker {
+            Worker(const BasicGRASP &grasp, std::seed_seq &seeds)
+                : mt(seeds), solution(grasp.instance_), incumbent(grasp.instance_), constructor(grasp.constructor_), ls(grasp.ls_) {}
+
+            /// Generator of the thread
+            Rng mt;
+
+            /// Solution built and improved at every iteration, recycled by the following ones
+            Solution solution;
+
+            /// Incumbent of the thread, used with IncumbentPolicy::ThreadLocal
+            Solution incumbent;
+
+            /// Iteration that produced incumbent, used in reproducible mode
+            std::size_t incumbent_iteration{no_iteration};
+
+            /// Copy of the constructor
+            Constructor constructor;
+
+            /// Copy of the local search
+            LS ls;
+
+            /// Filter used by the thread: statistics of the previous solves plus the ones collected by the thread
+            std::optional<Filtering> filter;
+
+            /// Statistics collected by the thread in the current solve, merged at its end
+            std::optional<Filtering> new_samples;
+
+            /// Probabilities and statistics of the reactive parameter, in reactive mode
+            std::optional<ReactiveParameter::Local> reactive;
+        };
+
         /*! @brief  Fire up a single thread.
          *
          *  @param   thread_id     Progressive id of the thread.
+         *  @param   worker        State of the thread.
          */
-        void start_thread(std::uint32_t thread_id, std::mt19937 &mt) {
-            auto solution_constructor = constructor_->clone();
-            std::unique_ptr<LocalSearch<Solution>> ls{nullptr};
-            if (ls_) {
-                ls = ls_->clone();
-            }
+        void start_thread([[maybe_unused]] std::uint32_t thread_id, Worker &worker) {
+            auto &mt = worker.mt;
+            auto &best_solution = incumbent_policy_ == IncumbentPolicy::Shared ? best_solution_ : worker.incumbent;
+            auto &solution_constructor = worker.constructor;
+            auto &ls = worker.ls;
+            auto has_ls = engaged(ls);
 
-            unsigned int current_thread_iteration = 0;
             while (true) {
-                ++current_thread_iteration;
-                auto global_iteration = 0;
-                {
-                    std::lock_guard _(current_iteration_mutex_);
-                    global_iteration = ++current_iteration_;
+                // Stop checks only read atomics, so they never block
+                if (stop_.stop_requested()) {
+                    break;
                 }
 
-                if (max_iterations_ > 0 && current_thread_iteration > max_iterations_) {
+                auto global_iteration = current_iteration_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+                if (max_iterations_ > 0 && global_iteration > max_iterations_) {
                     break;
                 }
 
@@ -113,40 +332,80 @@ namespace dferone::algorithms {
                     }
                 }
 
-                auto c = threadsafe_get_solution_cost(best_solution_, best_solution_mutex_);
-                if (c <= target_) {
+                if (best_cost_.load(std::memory_order_acquire) <= target_) {
                     break;
                 }
 
-                auto s = solution_constructor->createSolution(instance_, mt);
-                auto new_best = updateBestSolution(s);
-                AlgorithmStatus<Solution> status(s, best_solution_);
+                if (reproducible_) {
+                    mt = iteration_engine(global_iteration);
+                }
+
+                std::size_t parameter = 0;
+                if (worker.reactive) {
+                    parameter = worker.reactive->draw(mt);
+                    if constexpr (requires { solution_constructor.setParameter(0.0); }) {
+                        solution_constructor.setParameter(reactive_->value(parameter));
+                    }
+                }
+
+                // The solution of the previous iteration is rebuilt in place, reusing its buffers
+                auto &s = worker.solution;
+                construct(solution_constructor, s, mt);
+                auto construction_cost = s.getCost();
+
+                // Without local search nor visitor nothing reads the solution after the update, which can take it by swap
+                auto last_use = !has_ls && !engaged(visitor_);
+                auto new_best = updateBestSolution(s, global_iteration, worker, last_use);
+                AlgorithmStatus<Solution> status(s, best_solution);
                 status.new_best_ = new_best;
                 status.iteration_ = global_iteration;
 
                 auto perform_ls = true;
-                if (visitor_) {
-                    // Visitor can modify best_solution
-                    std::lock_guard _(best_solution_mutex_);
-                    perform_ls = visitor_->on_construction_end(status);
+                if (engaged(visitor_)) {
+                    perform_ls = visit([&] { return static_cast<bool>(visitor_.on_construction_end(status)); });
+                }
+
+                auto record_sample = false;
+                if (has_ls && perform_ls && worker.filter) {
+                    record_sample = filtering_samples_.load(std::memory_order_relaxed) < filtering_warmup_ || worker.filter->getCount() < 2;
+                    perform_ls = record_sample || worker.filter->check(construction_cost, best_cost_.load(std::memory_order_acquire));
+                }
+
+                if (has_ls && perform_ls) {
+                    ls.search(s, mt);
+                    if (record_sample) {
+                        filtering_samples_.fetch_add(1, std::memory_order_relaxed);
+                        worker.filter->addElement(construction_cost, s.getCost());
+                        worker.new_samples->addElement(construction_cost, s.getCost());
+                    }
                 }
 
-                if (ls) {
-                    ls->search(s, mt);
+                // Without local search the solution may have already been swapped away
+                if (worker.reactive && worker.reactive->record(parameter, has_ls ? s.getCost() : construction_cost)) {
+                    reactive_->flush(*worker.reactive, best_cost_.load(std::memory_order_acquire));
                 }
 
-                status.new_best_ = updateBestSolution(s) || new_best;
-                if (visitor_) {
-                    // Visitor can modify best_solution
-                    std::lock_guard _(best_solution_mutex_);
-                    visitor_->on_iteration_end(status);
+                // A visitor reads the solution after the update: it can be swapped into the incumbent only if no other thread replaces it
+                auto steal = !engaged(visitor_) || incumbent_policy_ == IncumbentPolicy::ThreadLocal;
+                auto improved = !last_use && updateBestSolution(s, global_iteration, worker, steal);
+                status.new_best_ = improved || new_best;
+                if (engaged(visitor_)) {
+                    AlgorithmStatus<Solution> end_status(improved && steal ? best_solution : s, best_solution);
+                    end_status.new_best_ = status.new_best_;
+                    end_status.iteration_ = global_iteration;
+                    visit([&] { visitor_.on_iteration_end(end_status); });
                 }
 
-                if (status.new_best_) {
+                if (status.new_best_ && verbose_) {
                     std::lock_guard _(printing_mutex_);
-                    LOG(INFO) << "Iteration " << current_iteration_ << ": updating best solution to " << status.best_solution_.getCost();
+                    std::cout << console::notice << "Iteration " << global_iteration << ": updating best solution to "
+                              << best_cost_.load(std::memory_order_relaxed) << '\n';
                 }
             }
+
+            if (worker.reactive) {
+                reactive_->flush(*worker.reactive, best_cost_.load(std::memory_order_acquire));
+            }
         }
 
         /*! @brief  Fire up many threads.
@@ -154,71 +413,277 @@ namespace dferone::algorithms {
          *  @param   num_threads   Number of threads to start
          */
         void start_threads(std::uint32_t num_threads) {
-            std::vector<std::mt19937> generators_;
+            // Workers of previous solves are reused, only the missing ones are created
+            workers_.reserve(num_threads);
+            for (auto i = static_cast<std::uint32_t>(workers_.size()); i < num_threads; ++i) {
+                // The seed sequence spreads a few words over the whole state of the engine
+                std::array<std::mt19937::result_type, 8> random_data{};
+                std::ranges::generate(random_data, std::ref(generator_));
+                std::seed_seq seeds(random_data.begin(), random_data.end());
+                workers_.emplace_back(*this, seeds);
+            }
 
-            for (auto i = 0u; i < num_threads; ++i) {
-                std::mt19937::result_type random_data[std::mt19937::state_size];
-                auto g = [this]() { return generator_(); };
-                std::generate(std::begin(random_data), std::end(random_data), g);
-                std::seed_seq seeds(std::begin(random_data), std::end(random_data));
-                generators_.emplace_back(seeds);
+            for (auto &worker : workers_) {
+                worker.filter = filtering_;
+                if (filtering_) {
+                    worker.new_samples.emplace(filtering_->getQ());
+                }
+                worker.reactive.reset();
+                if (reactive_) {
+                    worker.reactive.emplace(reactive_->local(best_cost_.load(std::memory_order_relaxed)));
+                }
             }
 
-            std::vector<std::jthread> threads(num_threads);
-            for (auto i = 0u; i < num_threads; ++i) {
-                threads[i] = std::jthread([i, &generators_, this]() { start_thread(i, generators_[i]); });
+            auto job = [this](std::uint32_t i) { start_thread(i, workers_[i]); };
+            if (pool_) {
+                pool_->run(num_threads, job);
+            } else {
+                ThreadPool pool(num_threads);
+                pool.run(num_threads, job);
             }
 
-            for (auto &thread : threads) {
-                thread.join();
+            if (filtering_) {
+                for (auto i = 0u; i < num_threads; ++i) {
+                    filtering_->merge(*workers_[i].new_samples);
+                }
             }
         }
 
-        /*! @brief Gets a solution's cost (but first locks the corresponding mutex).
+        /** @brief Engine of an iteration in reproducible mode
          *
-         *  @param sol       The solution of which we need the cost.
-         *  @param sol_mutex The mutex protecting the solution.
-         *  @return          The cost of the solution.
+         * The key only depends on the seed, the solve and the iteration, and SplitMix64::mix decorrelates
+         * consecutive keys, so the engines can be seeded with a single word.
          */
-        double threadsafe_get_solution_cost(const Solution &sol, std::mutex &sol_mutex) {
-            std::lock_guard<std::mutex> _(sol_mutex);
-            return sol.getCost();
+        Rng iteration_engine(std::size_t iteration) const {
+            using random::SplitMix64;
+            auto key = SplitMix64::mix(SplitMix64::mix(SplitMix64::mix(seed_) + solve_index_) + iteration);
+            // An engine with a narrower seed (e.g. std::mt19937 takes it mod 2^32) would map different keys to the same stream
+            if constexpr (std::constructible_from<Rng, typename Rng::result_type> && Rng::max() >= std::numeric_limits<std::uint64_t>::max()) {
+                return Rng(static_cast<typename Rng::result_type>(key));
+            } else {
+                std::seed_seq seeds{static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)};
+                return Rng(seeds);
+            }
+        }
+
+        /// @brief Whether (cost, iteration) beats (best_cost, best_iteration), in reproducible mode
+        static bool improves(double cost, std::size_t iteration, double best_cost, std::size_t best_iteration) {
+            return cost < best_cost || (cost == best_cost && iteration < best_iteration);
+        }
+
+        /// @brief Builds a solution into s, in place if the constructor supports it
+        void construct(Constructor &constructor, Solution &s, Rng &mt) {
+            if constexpr (requires { constructor.buildSolutionInto(instance_, s, mt); }) {
+                constructor.buildSolutionInto(instance_, s, mt);
+            } else {
+                s = constructor.createSolution(instance_, mt);
+            }
+        }
+
+        /// @brief Copies source into target, or swaps them if source is not needed any more
+        static void take(Solution &target, Solution &source, bool steal) {
+            if (steal) {
+                using std::swap;
+                swap(target, source);
+            } else {
+                target = source;
+            }
         }
 
         /** @brief Checks if the best solution must be updated
          *
-         * @param new_sol New solution to check
+         * @param new_sol   New solution to check
+         * @param iteration Iteration that produced new_sol
+         * @param worker    State of the calling thread
+         * @param steal     Whether new_sol can be swapped with the replaced solution instead of copied
          * @return True if the best solution has been updated, false otherwise
          */
-        bool updateBestSolution(const Solution &new_sol) {
+        bool updateBestSolution(Solution &new_sol, std::size_t iteration, Worker &worker, bool steal) {
+            auto cost = new_sol.getCost();
+
+            // Fast rejection without locking: most solutions do not improve the incumbent
+            auto best_cost = best_cost_.load(std::memory_order_acquire);
+            if (reproducible_ ? cost > best_cost : cost >= best_cost - eps_) {
+                return false;
+            }
+
+            if (reproducible_) {
+                return updateBestSolutionReproducible(new_sol, iteration, worker, steal);
+            }
+
+            if (incumbent_policy_ == IncumbentPolicy::ThreadLocal) {
+                // Claim the improvement on the published cost, then copy into the thread's own incumbent:
+                // the copy happens outside any critical section, and only for global improvements
+                while (cost < best_cost - eps_) {
+                    if (best_cost_.compare_exchange_weak(best_cost, cost, std::memory_order_acq_rel)) {
+                        take(worker.incumbent, new_sol, steal);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::lock_guard _(best_solution_mutex_);
+            if (cost < best_solution_.getCost() - eps_) {
+                take(best_solution_, new_sol, steal);
+                best_cost_.store(cost, std::memory_order_release);
+                return true;
+            }
+            return false;
+        }
+
+        /// @brief Exact version of updateBestSolution(), with ties broken by iteration
+        bool updateBestSolutionReproducible(Solution &new_sol, std::size_t iteration, Worker &worker, bool steal) {
             auto cost = new_sol.getCost();
+            if (incumbent_policy_ == IncumbentPolicy::ThreadLocal) {
+                // The published cost is a lower bound of the costs kept by the threads: whichever thread runs the
+                // best iteration records it, and merge_incumbents() picks it
+                if (!improves(cost, iteration, worker.incumbent.getCost(), worker.incumbent_iteration)) {
+                    return false;
+                }
+                take(worker.incumbent, new_sol, steal);
+                worker.incumbent_iteration = iteration;
+                auto best_cost = best_cost_.load(std::memory_order_acquire);
+                while (cost < best_cost) {
+                    if (best_cost_.compare_exchange_weak(best_cost, cost, std::memory_order_acq_rel)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
 
             std::lock_guard _(best_solution_mutex_);
-            auto best_cost = best_solution_.getCost();
-            if (cost < best_cost - eps_) {
-                best_solution_ = new_sol;
+            if (improves(cost, iteration, best_solution_.getCost(), best_iteration_)) {
+                take(best_solution_, new_sol, steal);
+                best_iteration_ = iteration;
+                best_cost_.store(cost, std::memory_order_release);
                 return true;
             }
             return false;
         }
 
+        /// @brief Whether a component is set: the adapters of the virtual interfaces can be empty, NoLocalSearch and NoVisitor never are
+        template<class Policy>
+        static bool engaged([[maybe_unused]] const Policy &policy) {
+            if constexpr (std::same_as<Policy, NoLocalSearch> || std::same_as<Policy, NoVisitor>) {
+                return false;
+            } else if constexpr (std::constructible_from<bool, const Policy &>) {
+                return static_cast<bool>(policy);
+            } else {
+                return true;
+            }
+        }
+
+        /// @brief Whether the visitor can be called by several threads at once
+        bool visitor_thread_safe() const {
+            if constexpr (requires { visitor_.is_thread_safe(); }) {
+                return visitor_.is_thread_safe();
+            } else {
+                return false;
+            }
+        }
+
+        /// @brief Calls the visitor, serializing the calls unless it is thread-safe
+        template<class F>
+        auto visit(F &&call) {
+            if (visitor_thread_safe()) {
+                return call();
+            }
+            // Visitor can modify best_solution
+            std::lock_guard _(best_solution_mutex_);
+            if constexpr (std::is_void_v<decltype(call())>) {
+                call();
+                publish_best_cost();
+            } else {
+                auto ret = call();
+                publish_best_cost();
+                return ret;
+            }
+        }
+
+        /// @brief Publishes the cost of best_solution_ after a visitor had the chance to modify it (best_solution_mutex_ must be held)
+        void publish_best_cost() {
+            if (incumbent_policy_ == IncumbentPolicy::Shared) {
+                best_cost_.store(best_solution_.getCost(), std::memory_order_release);
+            }
+        }
+
+        /// @brief Moves the best among the threads' incumbents into best_solution_
+        void merge_incumbents() {
+            using std::swap;
+            // Swapping keeps every incumbent valid for the next solve, as workers are reused
+            for (auto &worker : workers_) {
+                if (reproducible_) {
+                    if (improves(worker.incumbent.getCost(), worker.incumbent_iteration, best_solution_.getCost(), best_iteration_)) {
+                        swap(best_solution_, worker.incumbent);
+                        std::swap(best_iteration_, worker.incumbent_iteration);
+                    }
+                } else if (worker.incumbent.getCost() < best_solution_.getCost() - eps_) {
+                    swap(best_solution_, worker.incumbent);
+                }
+            }
+            best_cost_.store(best_solution_.getCost(), std::memory_order_release);
+        }
+
         /// Problem instance
         const ProblemInstance instance_;
 
+        /// Seed of the algorithm
+        std::uint64_t seed_;
+
         /// Generator
         mutable std::mt19937 generator_;
 
-        /// Constructor to clone in each thread
-        std::unique_ptr<SolutionConstructor<ProblemInstance, Solution>> constructor_{nullptr};
+        /// Number of solves started, part of the key of the iteration streams
+        std::uint64_t solve_index_{0};
+
+        /// Whether every iteration uses its own stream (see setReproducible())
+        bool reproducible_{false};
+
+        /// Iteration that produced best_solution_, used in reproducible mode
+        std::size_t best_iteration_{no_iteration};
+
+        /// Iteration of a solution not produced by any iteration
+        static constexpr std::size_t no_iteration = std::numeric_limits<std::size_t>::max();
 
-        /// Local search to clone in each thread
-        std::unique_ptr<LocalSearch<Solution>> ls_{nullptr};
+        /// Constructor to copy in each thread
+        Constructor constructor_;
+
+        /// Local search to copy in each thread
+        LS ls_;
 
         /// Best solution found
         Solution best_solution_;
 
-        /// Current iteration
-        std::size_t current_iteration_{0};
+        /// How the best solution is shared among the threads
+        IncumbentPolicy incumbent_policy_{IncumbentPolicy::Shared};
+
+        /// State of the threads, reused by the following solves
+        std::vector<Worker> workers_;
+
+        /// Filter of the local search with the statistics of the previous solves (if filtering is enabled)
+        std::optional<Filtering> filtering_;
+
+        /// Number of local searches always performed to estimate the improvement
+        std::size_t filtering_warmup_{0};
+
+        /// Number of improvements recorded so far
+        std::atomic<std::size_t> filtering_samples_{0};
+
+        /// Shared statistics of the reactive parameter (in reactive mode)
+        std::optional<ReactiveParameter> reactive_;
+
+        /// Pool of persistent threads (can be nullptr)
+        std::shared_ptr<ThreadPool> pool_{nullptr};
+
+        /// Current iteration, used as a ticket dispenser by the threads
+        std::atomic<std::size_t> current_iteration_{0};
+
+        /// Cost of best_solution_, published for lock-free reads
+        std::atomic<double> best_cost_{std::numeric_limits<double>::max()};
+
+        /// Token cancelling the current solve
+        std::stop_token stop_;
 
         /// Maximum number of iterations (0 means infinity)
         std::size_t max_iterations_{0};
@@ -234,7 +699,8 @@ namespace dferone::algorithms {
 
         std::mutex printing_mutex_;
 
-        std::mutex current_iteration_mutex_;
+        /// Whether the improvements are printed
+        bool verbose_{true};
 
         std::chrono::time_point<std::chrono::high_resolution_clock> start_time_;
 
@@ -242,6 +708,34 @@ namespace dferone::algorithms {
         static constexpr double eps_ = 1e-6;
 
         /// Visitor
-        std::unique_ptr<AlgorithmVisitor<Solution>> visitor_{nullptr};
+        Visitor visitor_;
+    };
+
+    /** @brief GRASP with the components implementing the virtual interfaces SolutionConstructor, LocalSearch and AlgorithmVisitor
+     *
+     *  Each thread clones the constructor and the local search. See BasicGRASP for the requirements on the types.
+     */
+    template<class ProblemInstance, GraspSolution Solution, std::uniform_random_bit_generator Rng = std::mt19937>
+        requires std::constructible_from<Rng, std::seed_seq &>
+    class GRASP : public BasicGRASP<ProblemInstance, Solution, VirtualSolutionConstructor<ProblemInstance, Solution, Rng>, VirtualLocalSearch<Solution, Rng>,
+                                    VirtualVisitor<Solution>, Rng> {
+    public:
+        GRASP(const ProblemInstance &instance, unsigned int seed) : GRASP::BasicGRASP(instance, seed) {}
+
+        /** @brief Add a Solution Costructor to construct a Solution at each GRASP iteration
+         *
+         * @param constructor SolutionConstructor<ProblemInstance, Solution, Rng> pointer
+         */
+        void addSolutionConstructor(std::unique_ptr<SolutionConstructor<ProblemInstance, Solution, Rng>> &&constructor) {
+            this->setSolutionConstructor(VirtualSolutionConstructor<ProblemInstance, Solution, Rng>(std::move(constructor)));
+        }
+
+        /** @brief Add a Local search to improve a Solution at each GRASP iteration
+         *
+         * @param ls LocalSearch<Solution, Rng> pointer
+         */
+        void addLocalSearch(std::unique_ptr<LocalSearch<Solution, Rng>> &&ls) { this->setLocalSearch(VirtualLocalSearch<Solution, Rng>(std::move(ls))); }
+
+        void addVisitor(std::unique_ptr<AlgorithmVisitor<Solution>> &&visitor) { this->setVisitor(VirtualVisitor<Solution>(std::move(visitor))); }
     };
 } // namespace dferone::algorithms
\ No newline at end of file
@@ -4,14 +4,78 @@
 
 #pragma once
 
+#include <concepts>
 #include <memory>
 #include <random>
+#include <utility>
 
 namespace dferone::algorithms {
 
-    template<class Solution>
+    /// @tparam Rng Random engine of the threads of the algorithm
+    template<class Solution, class Rng = std::mt19937>
     struct LocalSearch {
-        virtual void search(Solution &s, std::mt19937 &mt) = 0;
-        virtual std::unique_ptr<LocalSearch<Solution>> clone() const = 0;
+        /** @brief Improves a solution
+         *
+         * When GRASP runs on a ThreadPool, a long search can be split into subtasks with a
+         * ThreadPool::TaskGroup: they are stolen by the threads that have run out of iterations.
+         *
+         * @param s  The solution to improve
+         * @param mt The generator of the calling thread
+         */
+        virtual void search(Solution &s, Rng &mt) = 0;
+        virtual std::unique_ptr<LocalSearch<Solution, Rng>> clone() const = 0;
+        virtual ~LocalSearch() = default;
     };
-} // namespace dferone::algorithms
\ No newline at end of file
+
+    /** @brief Local search policy of BasicGRASP
+     *
+     * Every thread works on its own copy of the local search, so it can keep a state without locking.
+     */
+    template<class LS, class Solution, class Rng>
+    concept LocalSearchPolicy = std::copy_constructible<LS> && requires(LS ls, Solution &s, Rng &mt) { ls.search(s, mt); };
+
+    /// @brief Local search policy that skips the local search
+    struct NoLocalSearch {
+        template<class Solution, class Rng>
+        void search(Solution &, Rng &) {}
+    };
+
+    /// @brief Adapter of a LocalSearch to a LocalSearchPolicy: copies clone the wrapped local search
+    template<class Solution, class Rng = std::mt19937>
+    class VirtualLocalSearch {
+    public:
+        VirtualLocalSearch() = default;
+
+        explicit VirtualLocalSearch(std::unique_ptr<LocalSearch<Solution, Rng>> &&ls) : ls_(std::move(ls)) {}
+
+        VirtualLocalSearch(const VirtualLocalSearch &other) : ls_(other.ls_ ? other.ls_->clone() : nullptr) {}
+        VirtualLocalSearch(VirtualLocalSearch &&other) noexcept = default;
+        VirtualLocalSearch &operator=(VirtualLocalSearch other) noexcept {
+            ls_ = std::move(other.ls_);
+            return *this;
+        }
+
+        void search(Solution &s, Rng &mt) { ls_->search(s, mt); }
+
+        /// @return false if no local search is wrapped
+        explicit operator bool() const noexcept { return ls_ != nullptr; }
+
+    private:
+        std::unique_ptr<LocalSearch<Solution, Rng>> ls_{nullptr};
+    };
+
+    /// @brief Adapter of a LocalSearchPolicy to the LocalSearch interface, e.g. to add a PathRelinking to GRASP
+    template<class Policy, class Solution, class Rng = std::mt19937>
+        requires LocalSearchPolicy<Policy, Solution, Rng>
+    class PolicyLocalSearch : public LocalSearch<Solution, Rng> {
+    public:
+        explicit PolicyLocalSearch(Policy policy) : policy_(std::move(policy)) {}
+
+        void search(Solution &s, Rng &mt) override { policy_.search(s, mt); }
+
+        std::unique_ptr<LocalSearch<Solution, Rng>> clone() const override { return std::make_unique<PolicyLocalSearch>(policy_); }
+
+    private:
+        Policy policy_;
+    };
+} // namespace dferone::algorithms
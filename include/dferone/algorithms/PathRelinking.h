@@ -0,0 +1,155 @@
+#pragma once
+
+#include "EliteVisitor.h"
+#include "LocalSearch.h"
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace dferone::algorithms {
+
+    /// @brief Direction of the path between a local optimum and the elite solution that guides it
+    enum class RelinkingStrategy {
+        /// From the local optimum towards the elite solution
+        Forward,
+        /// From the elite solution towards the local optimum
+        Backward,
+        /// From both ends, alternately, until the two walks meet
+        Mixed
+    };
+
+    /** @brief Moves between two solutions, used by PathRelinking
+     *
+     * * distance(s, guide) is the number of moves needed to turn s into guide;
+     * * step(s, guide, mt) applies to s one of the moves towards guide, usually the one giving the best cost, reducing the distance by one.
+     *   The move must only depend on s, guide and the numbers drawn from mt, since PathRelinking replays the steps.
+     */
+    template<class Moves, class Solution, class Rng>
+    concept RelinkingMoves = std::copy_constructible<Moves> && requires(Moves m, Solution &s, const Solution &guide, Rng &mt) {
+        { m.distance(std::as_const(s), guide) } -> std::convertible_to<std::size_t>;
+        m.step(s, guide, mt);
+    };
+
+    /** @brief Local search policy that follows another local search with a path relinking stage
+     *
+     *  The local optimum is relinked with an elite solution drawn from a shared ElitePool, and replaced by the best
+     *  solution along the path, after improving it with the local search, if this is better; the solutions found are
+     *  then offered to the pool. Each thread of GRASP relinks its own local optima right after the local search,
+     *  so the relinking runs in parallel with the constructions of the other threads, and the copies of the threads
+     *  share the pool, whose diversity predicate keeps similar solutions out.
+     *
+     *  @tparam Solution The solution type.
+     *  @tparam Moves    Moves between two solutions, see RelinkingMoves.
+     *  @tparam LS       The local search to apply before the relinking, and to the best solution along the path.
+     *  @tparam Rng      Random engine of the threads.
+     */
+    template<class Solution, class Moves, class LS = NoLocalSearch, class Rng = std::mt19937>
+        requires RelinkingMoves<Moves, Solution, Rng> && LocalSearchPolicy<LS, Solution, Rng>
+    class PathRelinking {
+    public:
+        /** @param pool     The elite pool, shared with the caller to read it after (or during) the solve
+         *  @param moves    The moves between two solutions
+         *  @param ls       The local search
+         *  @param strategy The direction of the paths
+         */
+        explicit PathRelinking(std::shared_ptr<ElitePool<Solution>> pool, Moves moves = Moves(), LS ls = LS(),
+                               RelinkingStrategy strategy = RelinkingStrategy::Mixed)
+            : pool_(std::move(pool)), moves_(std::move(moves)), ls_(std::move(ls)), strategy_(strategy) {
+            if (!pool_) {
+                throw std::runtime_error("Path relinking without an elite pool!");
+            }
+        }
+
+        void search(Solution &s, Rng &mt) {
+            improve(s, mt);
+
+            auto guide = pool_->sample(mt);
+            if (guide && moves_.distance(std::as_const(s), *guide) > 1) {
+                auto best = strategy_ == RelinkingStrategy::Backward ? relink(*guide, s, mt) : relink(s, *guide, mt);
+                if (best) {
+                    improve(*best, mt);
+                    if (best->getCost() < s.getCost()) {
+                        using std::swap;
+                        swap(s, *best);
+                    }
+                    pool_->add(std::move(*best));
+                }
+            }
+            pool_->add(s);
+        }
+
+        /// @return The elite pool
+        [[nodiscard]] const std::shared_ptr<ElitePool<Solution>> &pool() const { return pool_; }
+
+    private:
+        /// Applies the local search, if any (a VirtualLocalSearch can be empty)
+        void improve(Solution &s, Rng &mt) {
+            if constexpr (std::constructible_from<bool, const LS &>) {
+                if (!static_cast<bool>(ls_)) {
+                    return;
+                }
+            }
+            ls_.search(s, mt);
+        }
+
+        /** @brief Returns the best solution strictly between start and end
+         *
+         * The walk only records how many steps lead to the best solution, which is then rebuilt by replaying them with a
+         * copy of the generator, instead of copying every improving solution along the path.
+         */
+        std::optional<Solution> relink(const Solution &start, const Solution &end, Rng &mt) {
+            auto replay_mt = mt;
+            std::size_t steps = 0;
+            std::size_t best_steps = 0;
+            auto best_cost = std::numeric_limits<double>::infinity();
+            walk(start, end, mt, std::numeric_limits<std::size_t>::max(), [&](const Solution &current) {
+                ++steps;
+                if (current.getCost() < best_cost) {
+                    best_cost = current.getCost();
+                    best_steps = steps;
+                }
+            });
+            if (best_steps == 0) {
+                return std::nullopt;
+            }
+            return walk(start, end, replay_mt, best_steps, [](const Solution &) {});
+        }
+
+        /// Applies at most max_steps moves from start towards end, calling visit after each, and returns the last solution moved
+        template<class Visit>
+        Solution walk(const Solution &start, const Solution &end, Rng &mt, std::size_t max_steps, Visit visit) {
+            Solution current = start;
+            if (strategy_ != RelinkingStrategy::Mixed) {
+                for (std::size_t i = 0; i < max_steps && moves_.distance(std::as_const(current), end) > 1; ++i) {
+                    moves_.step(current, end, mt);
+                    visit(std::as_const(current));
+                }
+                return current;
+            }
+
+            // The moves start alternately from the two ends, each towards the current solution of the other
+            Solution other = end;
+            for (std::size_t i = 0; i < max_steps && moves_.distance(std::as_const(current), other) > 1; ++i) {
+                moves_.step(current, other, mt);
+                visit(std::as_const(current));
+                using std::swap;
+                swap(current, other);
+            }
+            return other;
+        }
+
+        std::shared_ptr<ElitePool<Solution>> pool_;
+
+        Moves moves_;
+
+        LS ls_;
+
+        RelinkingStrategy strategy_;
+    };
+
+} // namespace dferone::algorithms
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../random.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dferone::algorithms {
+
+    /** @brief Adaptive choice of a parameter of the constructor (e.g. the greediness alpha of the RCL), as in Reactive GRASP
+     *
+     *  Value i is drawn with probability proportional to q_i = (z* / A_i)^delta, where A_i is the average cost of the
+     *  solutions built with it and z* is the best cost found, so costs must be positive; a value never drawn gets the
+     *  largest weight, 1. Every thread draws from its own Local, which accumulates the costs and adds them to the shared
+     *  atomic sums every block iterations, getting back the probabilities computed on the sums of all the threads.
+     */
+    class ReactiveParameter {
+    public:
+        /// @brief Statistics and probabilities of a single thread
+        class Local {
+        public:
+            /// @return The index of a value, drawn with the probabilities of the last flush
+            template<random::URBG Rng>
+            std::size_t draw(Rng &rng) const {
+                return table_(rng);
+            }
+
+            /** @brief Records the cost of a solution built with a value
+             *
+             *  @param i    Index of the value
+             *  @param cost Cost of the solution
+             *  @return true if a block is complete, and the statistics must be flushed
+             */
+            bool record(std::size_t i, double cost) {
+                sums_[i] += cost;
+                ++counts_[i];
+                return ++pending_ >= block_;
+            }
+
+        private:
+            friend class ReactiveParameter;
+
+            Local(std::vector<double> weights, std::size_t block) : sums_(weights.size(), 0.0), counts_(weights.size(), 0), block_(block), table_(weights) {}
+
+            std::vector<double> sums_;
+            std::vector<std::size_t> counts_;
+            std::size_t pending_{0};
+            std::size_t block_;
+            random::AliasTable table_;
+        };
+
+        /** @param values Values of the parameter
+         *  @param block  Iterations of a thread between two updates of its probabilities
+         *  @param delta  Amplification of the differences among the average costs
+         */
+        ReactiveParameter(std::vector<double> values, std::size_t block, double delta)
+            : values_(std::move(values)), block_(std::max<std::size_t>(block, 1)), delta_(delta), sums_(values_.size()), counts_(values_.size()) {
+            if (values_.empty()) {
+                throw std::runtime_error("Reactive parameter without values!");
+            }
+        }
+
+        /// @return The value of index i
+        [[nodiscard]] double value(std::size_t i) const { return values_[i]; }
+
+        /// @return The number of values
+        [[nodiscard]] std::size_t size() const { return values_.size(); }
+
+        /// @return The state of a new thread, with the current probabilities
+        [[nodiscard]] Local local(double best_cost) const { return Local(weights(best_cost), block_); }
+
+        /// @brief Adds the statistics of a thread to the shared ones, and updates its probabilities
+        void flush(Local &local, double best_cost) {
+            for (std::size_t i = 0; i < values_.size(); ++i) {
+                if (local.counts_[i] > 0) {
+                    sums_[i].fetch_add(local.sums_[i], std::memory_order_relaxed);
+                    counts_[i].fetch_add(local.counts_[i], std::memory_order_relaxed);
+                    local.sums_[i] = 0.0;
+                    local.counts_[i] = 0;
+                }
+            }
+            local.pending_ = 0;
+            local.table_ = random::AliasTable(weights(best_cost));
+        }
+
+        /// @return The probability of every value
+        [[nodiscard]] std::vector<double> probabilities(double best_cost) const {
+            auto ret = weights(best_cost);
+            auto total = std::accumulate(ret.begin(), ret.end(), 0.0);
+            for (auto &p : ret) {
+                p /= total;
+            }
+            return ret;
+        }
+
+    private:
+        /// Weights q_i, all equal if they cannot be computed (e.g. when no solution has been found yet)
+        std::vector<double> weights(double best_cost) const {
+            std::vector<double> ret(values_.size(), 1.0);
+            if (!(best_cost > 0.0 && std::isfinite(best_cost))) {
+                return ret;
+            }
+            auto total = 0.0;
+            for (std::size_t i = 0; i < values_.size(); ++i) {
+                auto count = counts_[i].load(std::memory_order_relaxed);
+                if (count > 0) {
+                    auto average = sums_[i].load(std::memory_order_relaxed) / static_cast<double>(count);
+                    ret[i] = average > 0.0 ? std::pow(std::min(best_cost / average, 1.0), delta_) : 1.0;
+                }
+                total += ret[i];
+            }
+            if (!(total > 0.0)) {
+                std::fill(ret.begin(), ret.end(), 1.0);
+            }
+            return ret;
+        }
+
+        std::vector<double> values_;
+        std::size_t block_;
+        double delta_;
+
+        /// Sums of the costs of the solutions built with every value, and their number
+        std::vector<std::atomic<double>> sums_;
+        std::vector<std::atomic<std::size_t>> counts_;
+    };
+
+} // namespace dferone::algorithms
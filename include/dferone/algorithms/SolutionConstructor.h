@@ -4,14 +4,80 @@
 
 #pragma once
 
+#include <concepts>
 #include <memory>
 #include <random>
+#include <utility>
 
 namespace dferone::algorithms {
 
-    template<class ProblemInstance, class Solution>
+    /// @tparam Rng Random engine of the threads of the algorithm
+    template<class ProblemInstance, class Solution, class Rng = std::mt19937>
     struct SolutionConstructor {
-        virtual Solution createSolution(const ProblemInstance &instance, std::mt19937 &mt) = 0;
-        virtual std::unique_ptr<SolutionConstructor<ProblemInstance, Solution>> clone() const = 0;
+        virtual Solution createSolution(const ProblemInstance &instance, Rng &mt) = 0;
+
+        /** @brief Builds a solution into s, which GRASP recycles from iteration to iteration
+         *
+         * s holds a solution of a previous iteration (or an empty one): overriding this method to overwrite it
+         * reuses its buffers, instead of allocating new ones at every iteration. By default it assigns the result
+         * of createSolution().
+         *
+         * @param instance The instance to solve
+         * @param s        The solution to overwrite
+         * @param mt       The generator of the calling thread
+         */
+        virtual void buildSolutionInto(const ProblemInstance &instance, Solution &s, Rng &mt) { s = createSolution(instance, mt); }
+
+        /** @brief Sets the parameter of the next constructions, e.g. the greediness alpha of the RCL
+         *
+         * Called before every construction when GRASP runs in reactive mode (see BasicGRASP::setReactive()).
+         * By default the parameter is ignored.
+         */
+        virtual void setParameter(double) {}
+
+        virtual std::unique_ptr<SolutionConstructor<ProblemInstance, Solution, Rng>> clone() const = 0;
+        virtual ~SolutionConstructor() = default;
+    };
+
+    /** @brief Constructor policy of BasicGRASP
+     *
+     * Every thread works on its own copy of the constructor, so it can keep a state without locking. The constructor
+     * either returns a new solution with createSolution(), or builds it with buildSolutionInto() into the one recycled by the
+     * thread (preferred if both are available).
+     */
+    template<class Constructor, class ProblemInstance, class Solution, class Rng>
+    concept SolutionConstructorPolicy =
+        std::copy_constructible<Constructor> &&
+        (requires(Constructor c, const ProblemInstance &instance, Rng &mt) {
+            { c.createSolution(instance, mt) } -> std::convertible_to<Solution>;
+        } || requires(Constructor c, const ProblemInstance &instance, Solution &s, Rng &mt) { c.buildSolutionInto(instance, s, mt); });
+
+    /// @brief Adapter of a SolutionConstructor to a SolutionConstructorPolicy: copies clone the wrapped constructor
+    template<class ProblemInstance, class Solution, class Rng = std::mt19937>
+    class VirtualSolutionConstructor {
+    public:
+        VirtualSolutionConstructor() = default;
+
+        explicit VirtualSolutionConstructor(std::unique_ptr<SolutionConstructor<ProblemInstance, Solution, Rng>> &&constructor)
+            : constructor_(std::move(constructor)) {}
+
+        VirtualSolutionConstructor(const VirtualSolutionConstructor &other) : constructor_(other.constructor_ ? other.constructor_->clone() : nullptr) {}
+        VirtualSolutionConstructor(VirtualSolutionConstructor &&other) noexcept = default;
+        VirtualSolutionConstructor &operator=(VirtualSolutionConstructor other) noexcept {
+            constructor_ = std::move(other.constructor_);
+            return *this;
+        }
+
+        Solution createSolution(const ProblemInstance &instance, Rng &mt) { return constructor_->createSolution(instance, mt); }
+
+        void buildSolutionInto(const ProblemInstance &instance, Solution &s, Rng &mt) { constructor_->buildSolutionInto(instance, s, mt); }
+
+        void setParameter(double parameter) { constructor_->setParameter(parameter); }
+
+        /// @return false if no constructor is wrapped
+        explicit operator bool() const noexcept { return constructor_ != nullptr; }
+
+    private:
+        std::unique_ptr<SolutionConstructor<ProblemInstance, Solution, Rng>> constructor_{nullptr};
     };
 } // namespace dferone::algorithms
\ No newline at end of file
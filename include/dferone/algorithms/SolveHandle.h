@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace dferone::algorithms {
+
+    /** @brief Handle of a solve running in background, returned by BasicGRASP::solve_async()
+     *
+     *  The progress is read without locking the solver, and the solve can be cancelled at any time: the threads stop
+     *  at the end of their current iteration, and the future gets the best solution found so far. Destroying the
+     *  handle cancels the solve and waits for it. The solver must outlive the handle, and must not be used until
+     *  the solve has completed.
+     *
+     *  @tparam Algorithm The solver, e.g. a BasicGRASP
+     */
+    template<class Algorithm>
+    class SolveHandle {
+    public:
+        using solution_type = typename Algorithm::solution_type;
+
+        SolveHandle(const Algorithm &algorithm, std::future<solution_type> result, std::jthread thread)
+            : algorithm_(&algorithm), result_(std::move(result)), thread_(std::move(thread)) {}
+
+        SolveHandle(SolveHandle &&other) noexcept = default;
+        SolveHandle &operator=(SolveHandle &&other) noexcept = default;
+
+        /// @brief Asks the solve to stop
+        /// @return false if the stop had already been requested
+        bool request_stop() noexcept { return thread_.request_stop(); }
+
+        /// @return The token the solve is cancelled through, e.g. to register a std::stop_callback
+        [[nodiscard]] std::stop_token get_stop_token() const noexcept { return thread_.get_stop_token(); }
+
+        /// @return The cost of the best solution found so far
+        [[nodiscard]] double best_cost() const { return algorithm_->getBestCost(); }
+
+        /// @return The number of iterations started so far
+        [[nodiscard]] std::size_t iterations() const { return algorithm_->getIterations(); }
+
+        /// @return true if the solve has completed, and get() would not block
+        [[nodiscard]] bool ready() const { return result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+        /// @return The future of the final solution
+        [[nodiscard]] std::future<solution_type> &future() noexcept { return result_; }
+
+        /// @brief Waits for the solve to complete
+        /// @return The best solution found, or rethrows the error of the solve
+        solution_type get() { return result_.get(); }
+
+    private:
+        const Algorithm *algorithm_;
+
+        std::future<solution_type> result_;
+
+        /// Declared last, so that the destructor joins the solve before releasing the rest
+        std::jthread thread_;
+    };
+
+} // namespace dferone::algorithms
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dferone::algorithms {
+
+    /** @brief A pool of persistent threads running fork-join jobs
+     *
+     *  The threads are started by the constructor and stay alive until the pool is destroyed,
+     *  so that running a job only costs a wake up of the workers.
+     *
+     *  While running a job, a thread can split its work into subtasks with a TaskGroup. Subtasks are
+     *  pushed on a per-thread deque: the owner pops them in LIFO order, while the threads that have
+     *  already finished the job steal them in FIFO order. This is a simple form of work stealing: every
+     *  deque is a std::deque of std::function guarded by a mutex, and the idle threads poll the deques,
+     *  sleeping between two empty polls with a backoff that doubles up to 100 microseconds.
+     *
+     *  A job cannot run another job on its own pool, which would wait forever for the threads running it.
+     */
+    class ThreadPool {
+    public:
+        /** @brief A set of subtasks spawned by a thread of the pool, that can be waited for
+         *
+         *  If the group is created outside a thread of the pool, the subtasks are run immediately.
+         */
+        class TaskGroup {
+        public:
+            TaskGroup() : pool_(current_pool_), id_(current_id_) {}
+
+            TaskGroup(const TaskGroup &) = delete;
+            TaskGroup &operator=(const TaskGroup &) = delete;
+
+            /// @brief Waits for the subtasks still pending
+            ~TaskGroup() {
+                try {
+                    wait();
+                } catch (...) {
+                }
+            }
+
+            /** @brief Spawns a subtask
+             *
+             * @param task Function to run, possibly on another thread
+             */
+            void run(std::function<void()> task) {
+                if (!pool_) {
+                    task();
+                    return;
+                }
+
+                pending_.fetch_add(1, std::memory_order_relaxed);
+                pool_->push(id_, [this, task = std::move(task)]() {
+                    try {
+                        task();
+                    } catch (...) {
+                        std::lock_guard _(error_mutex_);
+                        if (!error_) {
+                            error_ = std::current_exception();
+                        }
+                    }
+                    pending_.fetch_sub(1, std::memory_order_release);
+                });
+            }
+
+            /** @brief Waits for all the subtasks, running pending subtasks in the meanwhile
+             *
+             * The first exception thrown by a subtask is rethrown here.
+             */
+            void wait() {
+                while (pending_.load(std::memory_order_acquire) > 0) {
+                    if (!pool_->run_pending_task(id_)) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                std::lock_guard _(error_mutex_);
+                if (error_) {
+                    std::rethrow_exception(std::exchange(error_, nullptr));
+                }
+            }
+
+        private:
+            ThreadPool *pool_;
+            std::uint32_t id_;
+            std::atomic<std::size_t> pending_{0};
+            std::mutex error_mutex_;
+            std::exception_ptr error_;
+        };
+
+        /** @brief Starts the threads of the pool
+         *
+         * @param num_threads Number of threads in the pool
+         */
+        explicit ThreadPool(std::uint32_t num_threads) {
+            queues_.reserve(num_threads);
+            for (auto i = 0u; i < num_threads; ++i) {
+                queues_.push_back(std::make_unique<TaskQueue>());
+            }
+            threads_.reserve(num_threads);
+            for (auto i = 0u; i < num_threads; ++i) {
+                threads_.emplace_back([this, i](std::stop_token stop) { worker_loop(i, stop); });
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /// @brief Stops and joins all the threads
+        ~ThreadPool() {
+            for (auto &thread : threads_) {
+                thread.request_stop();
+            }
+            wake_cv_.notify_all();
+        }
+
+        /// @return The number of threads in the pool
+        [[nodiscard]] std::uint32_t size() const noexcept { return static_cast<std::uint32_t>(threads_.size()); }
+
+        /// @return true if the calling thread is one of the threads of the pool
+        [[nodiscard]] bool owns_current_thread() const noexcept { return current_pool_ == this; }
+
+        /** @brief Runs a job on the first num_workers threads and waits for all of them to finish
+         *
+         * Calls from different threads are serialised. If the job throws, the first exception is
+         * rethrown here once all the workers have finished. Threads that finish the job early
+         * steal the subtasks spawned by the others until every thread is done.
+         *
+         * @param num_workers Number of threads running the job
+         * @param job         Function called with the id of the thread, in [0, num_workers)
+         * @throws std::runtime_error if num_workers is greater than size(), or if called from a thread of this pool
+         */
+        void run(std::uint32_t num_workers, std::function<void(std::uint32_t)> job) {
+            if (num_workers > size()) {
+                throw std::runtime_error("Not enough threads in the pool!");
+            }
+            if (owns_current_thread()) {
+                throw std::runtime_error("A job cannot run another job on its own pool!");
+            }
+
+            std::lock_guard run_lock(run_mutex_);
+            std::unique_lock lock(mutex_);
+            job_ = std::move(job);
+            num_workers_ = num_workers;
+            pending_ = num_workers;
+            running_.store(num_workers, std::memory_order_relaxed);
+            error_ = nullptr;
+            ++generation_;
+            wake_cv_.notify_all();
+
+            done_cv_.wait(lock, [this]() { return pending_ == 0; });
+            job_ = nullptr;
+            if (error_) {
+                std::rethrow_exception(error_);
+            }
+        }
+
+    private:
+        /// Deque of the subtasks spawned by a thread
+        struct TaskQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /// Pushes a subtask on the deque of thread id
+        void push(std::uint32_t id, std::function<void()> task) {
+            auto &queue = *queues_[id];
+            std::lock_guard _(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        /** @brief Runs a single subtask: the newest of thread id, or the oldest stolen from another thread
+         *
+         * @return False if no subtask was found
+         */
+        bool run_pending_task(std::uint32_t id) {
+            std::function<void()> task;
+            {
+                auto &queue = *queues_[id];
+                std::lock_guard _(queue.mutex);
+                if (!queue.tasks.empty()) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+            }
+
+            for (auto i = 1u; !task && i < queues_.size(); ++i) {
+                auto &queue = *queues_[(id + i) % queues_.size()];
+                std::lock_guard _(queue.mutex);
+                if (!queue.tasks.empty()) {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+            }
+
+            if (!task) {
+                return false;
+            }
+            task();
+            return true;
+        }
+
+        /// Steals subtasks from the threads still running the job, backing off when there is nothing to steal
+        void help_until_done(std::uint32_t id) {
+            auto backoff = std::chrono::microseconds(1);
+            while (running_.load(std::memory_order_acquire) > 0) {
+                if (run_pending_task(id)) {
+                    backoff = std::chrono::microseconds(1);
+                } else {
+                    std::this_thread::sleep_for(backoff);
+                    backoff = std::min(backoff * 2, std::chrono::microseconds(100));
+                }
+            }
+        }
+
+        /// Body of every thread: waits for a new generation and runs the job if it is among the first num_workers_
+        void worker_loop(std::uint32_t id, std::stop_token stop) {
+            current_pool_ = this;
+            current_id_ = id;
+            std::uint64_t seen_generation = 0;
+            while (true) {
+                std::unique_lock lock(mutex_);
+                if (!wake_cv_.wait(lock, stop, [&]() { return generation_ != seen_generation; })) {
+                    return;
+                }
+                seen_generation = generation_;
+                if (id >= num_workers_) {
+                    continue;
+                }
+
+                lock.unlock();
+                try {
+                    job_(id);
+                } catch (...) {
+                    std::lock_guard _(mutex_);
+                    if (!error_) {
+                        error_ = std::current_exception();
+                    }
+                }
+                running_.fetch_sub(1, std::memory_order_release);
+                help_until_done(id);
+                lock.lock();
+
+                if (--pending_ == 0) {
+                    done_cv_.notify_one();
+                }
+            }
+        }
+
+        /// Serialises concurrent calls to run()
+        std::mutex run_mutex_;
+
+        /// Protects the state of the current job
+        std::mutex mutex_;
+
+        std::condition_variable_any wake_cv_;
+
+        std::condition_variable done_cv_;
+
+        /// Job of the current generation
+        std::function<void(std::uint32_t)> job_;
+
+        /// Number of threads running the current job
+        std::uint32_t num_workers_{0};
+
+        /// Number of threads that have not finished the current job yet
+        std::uint32_t pending_{0};
+
+        /// Incremented at every job
+        std::uint64_t generation_{0};
+
+        /// First exception thrown by the current job
+        std::exception_ptr error_;
+
+        /// Number of threads still inside the current job (those done with it help the others)
+        std::atomic<std::uint32_t> running_{0};
+
+        /// Subtask deques, one per thread
+        std::vector<std::unique_ptr<TaskQueue>> queues_;
+
+        /// Pool owning the calling thread (nullptr outside the pool)
+        static inline thread_local ThreadPool *current_pool_{nullptr};
+
+        /// Id of the calling thread in its pool
+        static inline thread_local std::uint32_t current_id_{0};
+
+        /// Threads, declared last so that they are joined before the rest is destroyed
+        std::vector<std::jthread> threads_;
+    };
+
+} // namespace dferone::algorithms
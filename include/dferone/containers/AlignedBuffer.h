@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dferone::containers {
+
+    /// @brief Tag requesting a container whose elements are not initialised, because they will be overwritten
+    struct for_overwrite_t {
+        explicit for_overwrite_t() = default;
+    };
+
+    /// @brief Tag value for containers not initialising their elements
+    inline constexpr for_overwrite_t for_overwrite{};
+
+    /** @brief Contiguous buffer aligned to a cache line
+     *
+     *  All the capacity() elements are default-initialised when the buffer is allocated, which is
+     *  a no-op for trivial types: this makes allocating a large buffer O(1) when its content is
+     *  going to be overwritten anyway.
+     *
+     *  @tparam T         Type of the elements
+     *  @tparam Alignment Alignment of the first element, in bytes
+     */
+    template<class T, std::size_t Alignment = 64>
+    class AlignedBuffer {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        /// Actual alignment of the first element
+        static constexpr size_type alignment = std::max(Alignment, alignof(T));
+
+        AlignedBuffer() = default;
+
+        /// @param capacity Number of elements of the buffer
+        explicit AlignedBuffer(size_type capacity) { allocate(capacity); }
+
+        AlignedBuffer(const AlignedBuffer &other) {
+            allocate(other.capacity_);
+            std::copy_n(other.data_, capacity_, data_);
+        }
+
+        AlignedBuffer(AlignedBuffer &&other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), capacity_(std::exchange(other.capacity_, 0)) {}
+
+        AlignedBuffer &operator=(const AlignedBuffer &other) {
+            if (this != &other) {
+                AlignedBuffer copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        AlignedBuffer &operator=(AlignedBuffer &&other) noexcept {
+            AlignedBuffer moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+
+        ~AlignedBuffer() { release(); }
+
+        /** @brief Makes room for at least capacity elements
+         *
+         * The content is not preserved when the buffer grows; nothing is done if it is already large enough.
+         *
+         * @param capacity Number of elements needed
+         */
+        void reserve(size_type capacity) {
+            if (capacity > capacity_) {
+                release();
+                allocate(capacity);
+            }
+        }
+
+        void swap(AlignedBuffer &other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(capacity_, other.capacity_);
+        }
+
+        /// @return Pointer to the first element
+        [[nodiscard]] T *data() noexcept { return data_; }
+        [[nodiscard]] const T *data() const noexcept { return data_; }
+
+        /// @return Number of elements of the buffer
+        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+    private:
+        void allocate(size_type capacity) {
+            if (capacity == 0) {
+                return;
+            }
+            auto *memory = static_cast<T *>(::operator new(capacity * sizeof(T), std::align_val_t{alignment}));
+            try {
+                std::uninitialized_default_construct_n(memory, capacity);
+            } catch (...) {
+                ::operator delete(memory, std::align_val_t{alignment});
+                throw;
+            }
+            data_ = memory;
+            capacity_ = capacity;
+        }
+
+        void release() noexcept {
+            if (data_) {
+                std::destroy_n(data_, capacity_);
+                ::operator delete(data_, std::align_val_t{alignment});
+            }
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+
+        T *data_{nullptr};
+        size_type capacity_{0};
+    };
+
+} // namespace dferone::containers
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "HeapBestSet.h"
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dferone::containers {
+
+    /** @brief Set of the best elements that many threads can insert into concurrently
+     *
+     *  The elements are spread over shards, each one a HeapBestSet of the full capacity protected by its own mutex,
+     *  and merged on read by snapshot(). A candidate is first compared with an atomic threshold, the best
+     *  among the worst keys of the full shards: every full shard holds capacity elements at least as good,
+     *  so a candidate not better than the threshold cannot be among the best ones and is rejected without locking.
+     *
+     *  An optional diversity predicate keeps similar elements out of the set: a candidate similar to an element
+     *  of its shard replaces it only if it is better. Similar elements in different shards are filtered by snapshot().
+     *  With a predicate the threshold is a heuristic, as evictions can leave a shard with fewer good elements.
+     *
+     *  @tparam T          Type of the elements to store
+     *  @tparam KeyFn      Extracts from an element the key used to compare it, which must be an arithmetic type
+     *  @tparam comparator Keys comparator, returning true if lhs is better than rhs
+     */
+    template<class T, class KeyFn = std::identity, class comparator = std::greater<>>
+        requires std::is_arithmetic_v<std::remove_cvref_t<std::invoke_result_t<KeyFn, const T &>>>
+    class ConcurrentBestSet {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using key_type = std::remove_cvref_t<std::invoke_result_t<KeyFn, const T &>>;
+
+        /// Tells whether two elements are too similar to be both in the set
+        using similarity_type = std::function<bool(const T &, const T &)>;
+
+        /** @param capacity   The capacity of the set
+         *  @param num_shards Number of shards, usually the number of writer threads
+         *  @param similar    Diversity predicate (can be empty)
+         *  @param key        The key extractor
+         *  @param c          The keys comparator
+         */
+        ConcurrentBestSet(size_type capacity, size_type num_shards, similarity_type similar = {}, KeyFn key = KeyFn(), comparator c = comparator())
+            : capacity_(capacity), similar_(std::move(similar)), key_(key), c_(c) {
+            shards_.reserve(num_shards);
+            for (size_type i = 0; i < std::max<size_type>(num_shards, 1); ++i) {
+                shards_.push_back(std::make_unique<Shard>(capacity, ByKey{key_, c_}));
+            }
+        }
+
+        /// @brief Tells, without locking, whether an element could be inserted
+        [[nodiscard]] bool accepts(const value_type &element) const { return accepts_key(std::invoke(key_, element)); }
+
+        /** @brief Tries to insert an element
+         *
+         *  @param shard   Shard to insert into; several threads can use the same shard
+         *  @param element The element to insert
+         *  @return true if the element has been inserted
+         */
+        bool add(size_type shard, const value_type &element) { return insert(shard, element); }
+
+        bool add(size_type shard, value_type &&element) { return insert(shard, std::move(element)); }
+
+        /// @brief Tries to insert an element in the shard of the calling thread
+        bool add(const value_type &element) { return insert(thread_shard(), element); }
+
+        bool add(value_type &&element) { return insert(thread_shard(), std::move(element)); }
+
+        /// @return The best elements of all the shards, sorted from the best one
+        [[nodiscard]] std::vector<value_type> snapshot() const {
+            std::vector<value_type> all;
+            for (const auto &shard : shards_) {
+                std::lock_guard _(shard->mutex);
+                all.insert(all.end(), shard->set.begin(), shard->set.end());
+            }
+            std::sort(all.begin(), all.end(), ByKey{key_, c_});
+
+            std::vector<value_type> ret;
+            ret.reserve(std::min(capacity_, all.size()));
+            for (auto &element : all) {
+                if (ret.size() == capacity_) {
+                    break;
+                }
+                if (!similar_ || std::none_of(ret.begin(), ret.end(), [&](const auto &kept) { return similar_(kept, element); })) {
+                    ret.push_back(std::move(element));
+                }
+            }
+            return ret;
+        }
+
+        /** @brief Extracts a random element, e.g. a guiding solution for path relinking
+         *
+         *  The element is drawn uniformly from a random non-empty shard.
+         *
+         *  @return A copy of the element, or nothing if the set is empty
+         */
+        template<class Rng>
+        std::optional<value_type> sample(Rng &rng) const {
+            auto first = std::uniform_int_distribution<size_type>(0, shards_.size() - 1)(rng);
+            for (size_type k = 0; k < shards_.size(); ++k) {
+                const auto &shard = *shards_[(first + k) % shards_.size()];
+                std::lock_guard _(shard.mutex);
+                if (!shard.set.empty()) {
+                    return shard.set[std::uniform_int_distribution<size_type>(0, shard.set.size() - 1)(rng)];
+                }
+            }
+            return std::nullopt;
+        }
+
+        /// @return The current threshold, if any shard is full
+        [[nodiscard]] std::optional<key_type> threshold() const {
+            if (!has_threshold_.load(std::memory_order_acquire)) {
+                return std::nullopt;
+            }
+            return threshold_.load(std::memory_order_acquire);
+        }
+
+        /// @brief Empties the set; it must not be called concurrently with other methods
+        void clear() {
+            for (auto &shard : shards_) {
+                shard->set = HeapBestSet<T, ByKey>(capacity_, ByKey{key_, c_});
+            }
+            has_threshold_.store(false, std::memory_order_release);
+        }
+
+        /// @return The capacity of the set
+        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+        /// @return The number of shards
+        [[nodiscard]] size_type num_shards() const noexcept { return shards_.size(); }
+
+    private:
+        /// Compares the elements through their keys
+        struct ByKey {
+            KeyFn key;
+            comparator c;
+
+            bool operator()(const T &lhs, const T &rhs) const { return c(std::invoke(key, lhs), std::invoke(key, rhs)); }
+        };
+
+        /// A shard, on its own cache lines
+        struct alignas(64) Shard {
+            Shard(size_type capacity, ByKey by_key) : set(capacity, by_key) {}
+
+            mutable std::mutex mutex;
+            HeapBestSet<T, ByKey> set;
+        };
+
+        bool accepts_key(const key_type &key) const {
+            return !has_threshold_.load(std::memory_order_acquire) || c_(key, threshold_.load(std::memory_order_acquire));
+        }
+
+        size_type thread_shard() const { return std::hash<std::thread::id>{}(std::this_thread::get_id()) % shards_.size(); }
+
+        template<class U>
+        bool insert(size_type shard_id, U &&element) {
+            auto key = std::invoke(key_, element);
+            if (capacity_ == 0 || !accepts_key(key)) {
+                return false;
+            }
+
+            auto &shard = *shards_[shard_id % shards_.size()];
+            std::lock_guard _(shard.mutex);
+            auto &set = shard.set;
+            if (!set.accepts(element)) {
+                return false;
+            }
+
+            if (similar_) {
+                // Rifiuta l'elemento se ce n'è uno simile non peggiore, altrimenti lo sostituisce
+                auto is_similar = [&](const T &other) { return similar_(other, element); };
+                if (std::any_of(set.begin(), set.end(), [&](const T &other) { return is_similar(other) && !c_(key, std::invoke(key_, other)); })) {
+                    return false;
+                }
+                for (auto it = std::find_if(set.begin(), set.end(), is_similar); it != set.end(); it = std::find_if(set.begin(), set.end(), is_similar)) {
+                    set.pop(static_cast<size_type>(it - set.begin()));
+                }
+            }
+
+            set.add(std::forward<U>(element));
+            if (set.full()) {
+                raise_threshold(std::invoke(key_, set.worst()));
+            }
+            return true;
+        }
+
+        /// The threshold only improves, as the worst element of a full shard never gets worse
+        void raise_threshold(key_type key) {
+            std::lock_guard _(threshold_mutex_);
+            if (!has_threshold_.load(std::memory_order_relaxed) || c_(key, threshold_.load(std::memory_order_relaxed))) {
+                threshold_.store(key, std::memory_order_release);
+                has_threshold_.store(true, std::memory_order_release);
+            }
+        }
+
+        /// Capacità massima dell'insieme
+        size_type capacity_;
+
+        /// Predicato di diversità (può essere vuoto)
+        similarity_type similar_;
+
+        KeyFn key_;
+
+        comparator c_;
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+
+        /// Serializes the updates of the threshold, which are rare
+        std::mutex threshold_mutex_;
+
+        std::atomic<bool> has_threshold_{false};
+
+        std::atomic<key_type> threshold_{};
+    };
+
+} // namespace dferone::containers
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "AlignedBuffer.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <vector>
+
+namespace dferone::containers {
+
+    /** @brief Read-only sorted set laid out in Eytzinger (BFS) order, for fast lower_bound lookups
+     *
+     *  The element of rank r in sorted order is stored at the position that a binary search would visit, so
+     *  the first levels of the search share a few cache lines and the candidates of the following levels are
+     *  contiguous and can be prefetched. It pays off over a plain binary search when the vector does not fit
+     *  in cache; it cannot be modified, build a new one from the updated SortedVector instead.
+     *
+     *  @tparam T          Type of the elements
+     *  @tparam comparator Elements comparator, the same as the SortedVector it is built from
+     */
+    template<typename T, typename comparator = std::less<T>>
+    class EytzingerVector {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        /** @brief Builds the layout in O(n)
+         *
+         *  @param sorted A SortedVector, or any range sorted according to c
+         *  @param c      The comparator
+         */
+        template<std::ranges::random_access_range Range>
+            requires std::ranges::sized_range<Range>
+        explicit EytzingerVector(const Range &sorted, comparator c = comparator())
+            : n_(std::ranges::size(sorted)), elements_(n_ + 1), ranks_(n_ + 1), c_(c) {
+            build(std::ranges::begin(sorted), 0, 1);
+        }
+
+        /// @return The number of elements
+        [[nodiscard]] size_type size() const noexcept { return n_; }
+
+        [[nodiscard]] bool empty() const noexcept { return n_ == 0; }
+
+        /** @brief Finds the first element not less than value
+         *
+         *  @return The rank of the element in sorted order (the same index it has in the SortedVector), or size()
+         */
+        [[nodiscard]] size_type lower_bound(const value_type &value) const {
+            auto k = descend(value);
+            return k == 0 ? n_ : ranks_[k];
+        }
+
+        /// @return Pointer to an element equivalent to value, or nullptr
+        [[nodiscard]] const value_type *find(const value_type &value) const {
+            auto k = descend(value);
+            return k != 0 && !c_(value, elements_.data()[k]) ? elements_.data() + k : nullptr;
+        }
+
+        /// @return true if the set contains an element equivalent to value
+        [[nodiscard]] bool contains(const value_type &value) const { return find(value) != nullptr; }
+
+    private:
+        /// Elements per cache line: the search prefetches the log2(block)-th generation of descendants of the current node, which share a line
+        static constexpr size_type block = std::max<size_type>(1, 64 / sizeof(T));
+
+        /// Fills the subtree rooted in k with the elements starting at it, in order; returns the first unused element
+        template<class It>
+        size_type build(It first, size_type i, size_type k) {
+            if (k <= n_) {
+                i = build(first, i, 2 * k);
+                elements_.data()[k] = first[static_cast<std::ptrdiff_t>(i)];
+                ranks_[k] = i++;
+                i = build(first, i, 2 * k + 1);
+            }
+            return i;
+        }
+
+        /// Branchless descent, returns the node of the lower bound (0 if all the elements are less than value)
+        size_type descend(const value_type &value) const {
+            const auto *data = elements_.data();
+            size_type k = 1;
+            while (k <= n_) {
+#if defined(__GNUC__)
+                // The address is computed on integers: it can point past the end, which prefetching tolerates
+                __builtin_prefetch(reinterpret_cast<const void *>(reinterpret_cast<std::uintptr_t>(data) + k * block * sizeof(T)));
+#endif
+                k = 2 * k + static_cast<size_type>(c_(data[k], value));
+            }
+            // Undo the right turns taken after the last left one
+            return k >> (std::countr_one(k) + 1);
+        }
+
+        size_type n_;
+
+        /// Elements in Eytzinger order, from position 1; position 0 is unused
+        AlignedBuffer<T> elements_;
+
+        /// Rank in sorted order of the element in each position
+        std::vector<size_type> ranks_;
+
+        comparator c_;
+    };
+
+} // namespace dferone::containers
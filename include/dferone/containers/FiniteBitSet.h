@@ -0,0 +1,276 @@
+#pragma once
+
+#include "AlignedBuffer.h"
+#include "FiniteSet.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace dferone::containers {
+
+    /** @brief A set of integers in [0, n), stored as a bitset
+     *
+     *  Companion of FiniteSet: it takes one bit per element of the universe instead of two indices, and
+     *  supports union, intersection and difference a 64-bit word at a time (four words at a time with AVX2).
+     *  Iteration visits the elements in increasing order, skipping empty words.
+     *
+     *  @tparam T Type of the elements
+     */
+    template<class T>
+        requires std::integral<T>
+    class FiniteBitSet {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using word_type = std::uint64_t;
+
+        /// @brief Forward iterator over the elements of the set, in increasing order
+        class const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = T;
+
+            const_iterator() = default;
+
+            value_type operator*() const { return static_cast<value_type>(word_ * bits_per_word + std::countr_zero(bits_)); }
+
+            const_iterator &operator++() {
+                bits_ &= bits_ - 1;
+                skip_empty_words();
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                auto old = *this;
+                ++*this;
+                return old;
+            }
+
+            bool operator==(const const_iterator &other) const { return word_ == other.word_ && bits_ == other.bits_; }
+
+        private:
+            friend class FiniteBitSet;
+
+            const_iterator(const word_type *words, size_type num_words, size_type word)
+                : words_(words), num_words_(num_words), word_(word), bits_(word < num_words ? words[word] : 0) {
+                skip_empty_words();
+            }
+
+            void skip_empty_words() {
+                while (bits_ == 0 && word_ < num_words_) {
+                    ++word_;
+                    bits_ = word_ < num_words_ ? words_[word_] : 0;
+                }
+            }
+
+            const word_type *words_{nullptr};
+            size_type num_words_{0};
+            size_type word_{0};
+            word_type bits_{0};
+        };
+
+        /// @name Constructors
+        /// @{
+
+        /// @param capacity The set can contain the values [0, capacity)
+        explicit FiniteBitSet(size_type capacity) : capacity_(capacity), num_words_(padded_words(capacity)), words_(num_words_) {
+            std::fill_n(words_.data(), num_words_, word_type{0});
+        }
+
+        FiniteBitSet(size_type capacity, std::initializer_list<value_type> list) : FiniteBitSet(capacity) {
+            for (auto el : list) {
+                add(el);
+            }
+        }
+
+        template<std::ranges::range Range>
+        FiniteBitSet(size_type capacity, const Range &r) : FiniteBitSet(capacity) {
+            for (auto el : r) {
+                add(el);
+            }
+        }
+
+        /// @brief Converts a FiniteSet, with the same capacity, whatever its index type
+        template<class Index>
+        explicit FiniteBitSet(const FiniteSet<T, Index> &fs) : FiniteBitSet(fs.capacity(), fs) {}
+        /// @}
+
+        /// @tparam Index Type of the positions of the FiniteSet (see FiniteSet)
+        /// @return The FiniteSet with the same elements
+        template<class Index = T>
+        [[nodiscard]] FiniteSet<T, Index> to_finite_set() const { return FiniteSet<T, Index>(capacity_, *this); }
+
+        /// @return The number of elements in the set
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+
+        /// @return true if the set is empty
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        /// @return The size of the universe
+        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+        /// @brief Adds an element in O(1); values outside [0, capacity) are ignored
+        void add(value_type el) noexcept {
+            if (static_cast<size_type>(el) < capacity_) {
+                auto &word = words_.data()[word_of(el)];
+                auto mask = mask_of(el);
+                size_ += (word & mask) == 0;
+                word |= mask;
+            }
+        }
+
+        /// @brief Removes an element in O(1)
+        void remove(value_type el) noexcept {
+            if (static_cast<size_type>(el) < capacity_) {
+                auto &word = words_.data()[word_of(el)];
+                auto mask = mask_of(el);
+                size_ -= (word & mask) != 0;
+                word &= ~mask;
+            }
+        }
+
+        /// @return true if the set contains el
+        [[nodiscard]] bool contains(value_type el) const noexcept {
+            return static_cast<size_type>(el) < capacity_ && (words_.data()[word_of(el)] & mask_of(el)) != 0;
+        }
+
+        /// @return 1 if the set contains el, 0 otherwise
+        [[nodiscard]] size_type count(value_type el) const noexcept { return contains(el) ? 1 : 0; }
+
+        /// @brief Empties the set
+        void reset() noexcept {
+            std::fill_n(words_.data(), num_words_, word_type{0});
+            size_ = 0;
+        }
+
+        /// @name Set operations
+        /// Both sets must have the same capacity
+        /// @{
+
+        /// @brief Union
+        FiniteBitSet &operator|=(const FiniteBitSet &other) {
+            combine<SetOperation::Union>(other);
+            return *this;
+        }
+
+        /// @brief Intersection
+        FiniteBitSet &operator&=(const FiniteBitSet &other) {
+            combine<SetOperation::Intersection>(other);
+            return *this;
+        }
+
+        /// @brief Difference
+        FiniteBitSet &operator-=(const FiniteBitSet &other) {
+            combine<SetOperation::Difference>(other);
+            return *this;
+        }
+
+        friend FiniteBitSet operator|(FiniteBitSet lhs, const FiniteBitSet &rhs) { return lhs |= rhs; }
+        friend FiniteBitSet operator&(FiniteBitSet lhs, const FiniteBitSet &rhs) { return lhs &= rhs; }
+        friend FiniteBitSet operator-(FiniteBitSet lhs, const FiniteBitSet &rhs) { return lhs -= rhs; }
+
+        /// @return The size of the intersection, without building it
+        [[nodiscard]] size_type intersection_size(const FiniteBitSet &other) const noexcept {
+            assert(capacity_ == other.capacity_);
+            size_type count = 0;
+            for (size_type i = 0; i < num_words_; ++i) {
+                count += static_cast<size_type>(std::popcount(words_.data()[i] & other.words_.data()[i]));
+            }
+            return count;
+        }
+        /// @}
+
+        bool operator==(const FiniteBitSet &other) const noexcept {
+            return capacity_ == other.capacity_ && std::equal(words_.data(), words_.data() + num_words_, other.words_.data());
+        }
+
+        /// @name Iteration
+        /// @{
+        const_iterator cbegin() const noexcept { return const_iterator(words_.data(), num_words_, 0); }
+        const_iterator begin() const noexcept { return cbegin(); }
+        const_iterator cend() const noexcept { return const_iterator(words_.data(), num_words_, num_words_); }
+        const_iterator end() const noexcept { return cend(); }
+        /// @}
+
+        /// @return The words of the bitset: element i is bit i % 64 of word i / 64
+        [[nodiscard]] const word_type *words() const noexcept { return words_.data(); }
+
+        friend std::ostream &operator<<(std::ostream &os, const FiniteBitSet &fs) {
+            // join_and_print needs a bidirectional iterator
+            os << '{';
+            auto separator = "";
+            for (auto el : fs) {
+                os << std::exchange(separator, ", ") << el;
+            }
+            return os << '}';
+        }
+
+    private:
+        static constexpr size_type bits_per_word = 64;
+
+        /// Words are allocated in blocks of 64 bytes, so that SIMD loops need no tail
+        static size_type padded_words(size_type capacity) { return (capacity + 511) / 512 * 8; }
+
+        static size_type word_of(value_type el) { return static_cast<size_type>(el) / bits_per_word; }
+        static word_type mask_of(value_type el) { return word_type{1} << (static_cast<size_type>(el) % bits_per_word); }
+
+        enum class SetOperation { Union, Intersection, Difference };
+
+        /// Combines the words of the two sets and recounts the elements
+        template<SetOperation operation>
+        void combine(const FiniteBitSet &other) {
+            assert(capacity_ == other.capacity_);
+            auto *a = words_.data();
+            const auto *b = other.words_.data();
+#ifdef __AVX2__
+            for (size_type i = 0; i < num_words_; i += 4) {
+                auto x = _mm256_load_si256(reinterpret_cast<const __m256i *>(a + i));
+                auto y = _mm256_load_si256(reinterpret_cast<const __m256i *>(b + i));
+                if constexpr (operation == SetOperation::Union) {
+                    x = _mm256_or_si256(x, y);
+                } else if constexpr (operation == SetOperation::Intersection) {
+                    x = _mm256_and_si256(x, y);
+                } else {
+                    x = _mm256_andnot_si256(y, x);
+                }
+                _mm256_store_si256(reinterpret_cast<__m256i *>(a + i), x);
+            }
+#else
+            for (size_type i = 0; i < num_words_; ++i) {
+                if constexpr (operation == SetOperation::Union) {
+                    a[i] |= b[i];
+                } else if constexpr (operation == SetOperation::Intersection) {
+                    a[i] &= b[i];
+                } else {
+                    a[i] &= ~b[i];
+                }
+            }
+#endif
+            size_ = 0;
+            for (size_type i = 0; i < num_words_; ++i) {
+                size_ += static_cast<size_type>(std::popcount(a[i]));
+            }
+        }
+
+        size_type capacity_;
+        size_type num_words_;
+        size_type size_{0};
+        AlignedBuffer<word_type> words_;
+    };
+
+} // namespace dferone::containers
@@ -7,11 +7,15 @@
 
 #pragma once
 
+#include "../random.h"
 #include "containers.h"
 #include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <numeric>
+#include <span>
 #include <vector>
 
 namespace dferone::containers {
@@ -23,9 +27,17 @@ namespace dferone::containers {
     /// Però l'insieme doveva permettermi di verificare velocemente se
     /// un elemento facesse o meno parte dell'insieme e mi permettesse di
     /// iterare con facilità sia sugli elementi contenuti che sul complemento.
-
-    template<class T>
-        requires std::integral<T>
+    ///
+    /// Costi delle copie: elements_ e positions_ contengono sempre una permutazione di tutto [0, capacity), quindi
+    /// il costruttore e il costruttore di copia costano O(capacity). Solo l'assegnamento di copia fra insiemi con la
+    /// stessa capacità copia la sola parte attiva, in O(size() + other.size()), e solo quando entrambi gli insiemi
+    /// occupano meno di un ottavo della capacità: altrimenti copiare i vettori interi è più veloce. Per copiare
+    /// spesso un insieme piccolo conviene quindi assegnarlo a un insieme già costruito, invece di costruirne uno nuovo.
+    ///
+    /// @tparam T     Tipo degli elementi
+    /// @tparam Index Tipo delle posizioni degli elementi: deve poter rappresentare [0, capacity), T va sempre bene
+    template<class T, class Index = T>
+        requires std::integral<T> && std::integral<Index>
     class FiniteSet {
     public:
         /// Il tipo degli oggetti contenuti
@@ -95,9 +107,12 @@ namespace dferone::containers {
         /// Rimuove un elemento in O(1)
         inline const_iterator remove(const_iterator it) noexcept;
 
-        /// Svuota l'insieme
+        /// Svuota l'insieme in O(1): gli elementi restano in elements_, basta spostare il confine size_
         inline void reset() noexcept;
 
+        /// Sinonimo di reset()
+        inline void clear() noexcept { reset(); }
+
         /// @param el L'elemento da controllare
         /// @return true se l'insieme contriene el, false altrimenti
         inline bool contains(value_type el) const noexcept;
@@ -118,8 +133,9 @@ namespace dferone::containers {
         /// @param os Output stream su cui stampare
         /// @param fs Insieme da stmapare
         /// @return Output stream os
-        template<class R>
-        inline friend std::ostream &operator<<(std::ostream &os, const FiniteSet<R> &fs);
+        template<class R, class I>
+            requires std::integral<R> && std::integral<I>
+        inline friend std::ostream &operator<<(std::ostream &os, const FiniteSet<R, I> &fs);
 
         /// @name Iterazione
         /// @{
@@ -136,10 +152,56 @@ namespace dferone::containers {
         /// @return L'insieme complemento
         inline auto complement() const noexcept { return std::ranges::subrange(cend(), elements_.cend()); }
 
+        /// @name Campionamento
+        /// Gli elementi sono già in un array: si estraggono posizioni, senza std::advance
+        /// @{
+
+        /// @return Un elemento a caso dell'insieme, in O(1); l'insieme non deve essere vuoto
+        template<random::URBG Rng>
+        inline value_type random_element(Rng &rng) const {
+            assert(size_ > 0);
+            return elements_[random::bounded_rand(rng, size_)];
+        }
+
+        /// @brief Rimuove un elemento a caso, in O(1); l'insieme non deve essere vuoto
+        /// @return L'elemento rimosso
+        template<random::URBG Rng>
+        inline value_type random_remove(Rng &rng) {
+            auto el = random_element(rng);
+            remove(el);
+            return el;
+        }
+
+        /// @brief Campiona k elementi distinti dell'insieme, in O(k)
+        ///
+        /// Un passo parziale di Fisher–Yates porta il campione in testa a elements_: l'insieme
+        /// non cambia, cambia solo l'ordine di iterazione.
+        /// @return Gli elementi campionati, validi fino alla prossima modifica dell'insieme
+        template<random::URBG Rng>
+        inline std::span<const value_type> sample(size_type k, Rng &rng) {
+            assert(k <= size_);
+            shuffle_positions(0, size_, k, rng);
+            return {elements_.data(), k};
+        }
+
+        /// @brief Campiona k elementi distinti del complemento, in O(k)
+        /// @return Gli elementi campionati, validi fino alla prossima modifica dell'insieme
+        template<random::URBG Rng>
+        inline std::span<const value_type> sample_complement(size_type k, Rng &rng) {
+            assert(k <= capacity_ - size_);
+            shuffle_positions(size_, capacity_, k, rng);
+            return {elements_.data() + size_, k};
+        }
+        /// @}
+
         /// @name Operatori di assegnamento
         /// @{
 
         /// @param other Oggetto da copiare/spostare
+        ///
+        /// Se le capacità coincidono e other è piccolo rispetto alla capacità, viene copiata solo
+        /// la parte attiva in O(size() + other.size()); in questo caso il complemento può essere
+        /// visitato in un ordine diverso da quello di other
         inline FiniteSet &operator=(const FiniteSet &other);
         inline FiniteSet &operator=(FiniteSet &&other) noexcept;
         /// @}
@@ -148,11 +210,22 @@ namespace dferone::containers {
         /// Scambia gli elementi in posizione i e j
         inline void swappos(size_type i, size_type j) noexcept;
 
+        /// Fisher–Yates parziale sulle posizioni [first, last), mantenendo positions_ aggiornato
+        template<class Rng>
+        inline void shuffle_positions(size_type first, size_type last, size_type k, Rng &rng) noexcept {
+            for (size_type i = first; i < first + k; ++i) {
+                swappos(i, i + random::bounded_rand(rng, last - i));
+            }
+        }
+
+        /// Copia solo la parte attiva di other, che deve avere la stessa capacità
+        inline void copy_active(const FiniteSet &other) noexcept;
+
         /// Elementi dell'insieme
         std::vector<value_type> elements_;
 
         /// Posizioni degli elementi in elements_
-        std::vector<size_type> positions_;
+        std::vector<Index> positions_;
 
         /// Capacità massima dell'insieme
         size_type capacity_;
@@ -161,47 +234,45 @@ namespace dferone::containers {
         size_type size_;
     };
 
-    template<class T>
-        requires std::integral<T>
-    FiniteSet<T>::FiniteSet(size_type capacity, size_type size) : elements_(capacity), positions_(capacity), capacity_(capacity), size_(size) {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    FiniteSet<T, Index>::FiniteSet(size_type capacity, size_type size) : elements_(capacity), positions_(capacity), capacity_(capacity), size_(size) {
         if (size >= capacity)
             size_ = capacity;
 
-        for (unsigned int i = 0; i < capacity; ++i) {
-            elements_[i] = i;
-            positions_[i] = i;
-        }
+        std::iota(elements_.begin(), elements_.end(), value_type{0});
+        std::iota(positions_.begin(), positions_.end(), Index{0});
     }
 
-    template<class T>
-        requires std::integral<T>
-    [[maybe_unused]] FiniteSet<T>::FiniteSet(size_type capacity, std::initializer_list<value_type> list) : FiniteSet(capacity) {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    [[maybe_unused]] FiniteSet<T, Index>::FiniteSet(size_type capacity, std::initializer_list<value_type> list) : FiniteSet(capacity) {
         for (auto el : list) {
             this->add(el);
         }
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::size_type FiniteSet<T>::size() const noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::size_type FiniteSet<T, Index>::size() const noexcept {
         return size_;
     }
 
-    template<class T>
-        requires std::integral<T>
-    bool FiniteSet<T>::empty() const noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    bool FiniteSet<T, Index>::empty() const noexcept {
         return size_ == 0;
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::size_type FiniteSet<T>::capacity() const noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::size_type FiniteSet<T, Index>::capacity() const noexcept {
         return capacity_;
     }
 
-    template<class T>
-        requires std::integral<T>
-    void FiniteSet<T>::add(value_type el) noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    void FiniteSet<T, Index>::add(value_type el) noexcept {
         if (((size_type)el) < capacity_) {
             if (!contains(el)) {
                 swappos(positions_[(size_type)el], size_);
@@ -210,9 +281,9 @@ namespace dferone::containers {
         }
     }
 
-    template<class T>
-        requires std::integral<T>
-    void FiniteSet<T>::remove(value_type el) noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    void FiniteSet<T, Index>::remove(value_type el) noexcept {
         if (((size_type)el) < capacity_) {
             if (contains(el)) {
                 --size_;
@@ -221,9 +292,9 @@ namespace dferone::containers {
         }
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::const_iterator FiniteSet<T>::remove(typename FiniteSet<T>::const_iterator it) noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::const_iterator FiniteSet<T, Index>::remove(typename FiniteSet<T, Index>::const_iterator it) noexcept {
         // L'iteratore dell'array non viene inficiato,
         // dato che c'è solo uno scambio di elementi: questo elemento passa
         // all'indice size_ e l'elementi in quella posizione ora si troverà
@@ -233,74 +304,84 @@ namespace dferone::containers {
         return it;
     }
 
-    template<class T>
-        requires std::integral<T>
-    bool FiniteSet<T>::contains(value_type el) const noexcept {
-        return positions_[(size_type)el] < size_;
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    bool FiniteSet<T, Index>::contains(value_type el) const noexcept {
+        return static_cast<size_type>(positions_[(size_type)el]) < size_;
     }
 
-    template<class T>
-        requires std::integral<T>
-    void FiniteSet<T>::swappos(size_type i, size_type j) noexcept {
-        size_type prev_i = elements_[i];
-        size_type prev_j = elements_[j];
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    void FiniteSet<T, Index>::swappos(size_type i, size_type j) noexcept {
+        value_type prev_i = elements_[i];
+        value_type prev_j = elements_[j];
 
         elements_[i] = prev_j;
         elements_[j] = prev_i;
 
-        positions_[prev_j] = i;
-        positions_[prev_i] = j;
+        positions_[(size_type)prev_j] = static_cast<Index>(i);
+        positions_[(size_type)prev_i] = static_cast<Index>(j);
     }
 
-    template<class T>
-        requires std::integral<T>
-    inline std::ostream &operator<<(std::ostream &os, const FiniteSet<T> &fs) {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    inline std::ostream &operator<<(std::ostream &os, const FiniteSet<T, Index> &fs) {
         return os << '{' << dferone::containers::to_string(fs) << '}';
     }
 
-    template<class T>
-        requires std::integral<T>
-    void FiniteSet<T>::reset() noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    void FiniteSet<T, Index>::reset() noexcept {
         size_ = 0;
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::const_iterator FiniteSet<T>::cbegin() const noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::const_iterator FiniteSet<T, Index>::cbegin() const noexcept {
         return elements_.cbegin();
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::const_iterator FiniteSet<T>::cend() const noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::const_iterator FiniteSet<T, Index>::cend() const noexcept {
         return elements_.cbegin() + size_;
     }
 
-    template<class T>
-        requires std::integral<T>
-    FiniteSet<T>::~FiniteSet() = default;
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    FiniteSet<T, Index>::~FiniteSet() = default;
 
-    template<class T>
-        requires std::integral<T>
-    inline std::ostream &operator<<(std::ostream &os, const typename FiniteSet<T>::ComplementSet &cs) {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    inline std::ostream &operator<<(std::ostream &os, const typename FiniteSet<T, Index>::ComplementSet &cs) {
         return os << std::to_string(cs);
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::value_type FiniteSet<T>::operator[](FiniteSet::size_type pos) const noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::value_type FiniteSet<T, Index>::operator[](size_type pos) const noexcept {
         return elements_[pos];
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::value_type FiniteSet<T>::at(typename FiniteSet<T>::size_type pos) const {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::value_type FiniteSet<T, Index>::at(typename FiniteSet<T, Index>::size_type pos) const {
         return elements_.at(pos);
     }
 
-    template<class T>
-        requires std::integral<T>
-    FiniteSet<T> &FiniteSet<T>::operator=(const FiniteSet<T> &other) {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    FiniteSet<T, Index> &FiniteSet<T, Index>::operator=(const FiniteSet<T, Index> &other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        // Copiare i due vettori costa O(capacity): conviene solo quando l'insieme è quasi pieno
+        if (capacity_ == other.capacity_ && 8 * (size_ + other.size_) < capacity_) {
+            copy_active(other);
+            return *this;
+        }
+
         size_ = other.size_;
         capacity_ = other.capacity_;
         positions_ = other.positions_;
@@ -308,9 +389,9 @@ namespace dferone::containers {
         return *this;
     }
 
-    template<class T>
-        requires std::integral<T>
-    FiniteSet<T> &FiniteSet<T>::operator=(FiniteSet<T> &&other) noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    FiniteSet<T, Index> &FiniteSet<T, Index>::operator=(FiniteSet<T, Index> &&other) noexcept {
         size_ = other.size_;
         capacity_ = other.capacity_;
         positions_ = std::move(other.positions_);
@@ -318,9 +399,24 @@ namespace dferone::containers {
         return *this;
     }
 
-    template<class T>
-        requires std::integral<T>
-    typename FiniteSet<T>::size_type FiniteSet<T>::count(FiniteSet<T>::value_type el) const noexcept {
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    void FiniteSet<T, Index>::copy_active(const FiniteSet<T, Index> &other) noexcept {
+        // Dopo gli add il prefisso contiene gli stessi elementi di other, quindi
+        // copiarne l'ordine lascia elements_ e positions_ una permutazione valida
+        reset();
+        for (size_type i = 0; i < other.size_; ++i) {
+            add(other.elements_[i]);
+        }
+        for (size_type i = 0; i < other.size_; ++i) {
+            elements_[i] = other.elements_[i];
+            positions_[(size_type)elements_[i]] = static_cast<Index>(i);
+        }
+    }
+
+    template<class T, class Index>
+        requires std::integral<T> && std::integral<Index>
+    typename FiniteSet<T, Index>::size_type FiniteSet<T, Index>::count(FiniteSet<T, Index>::value_type el) const noexcept {
         if (this->contains(el)) {
             return 1;
         }
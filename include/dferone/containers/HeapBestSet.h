@@ -0,0 +1,271 @@
+#pragma once
+
+#include "containers.h"
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace dferone::containers {
+
+    /** @brief Fixed sized set of the best elements, stored as a heap with the worst element at the root
+     *
+     *  Same interface as BestSet, but add() is O(log k) instead of O(k), so it is suited to large pools
+     *  of elite solutions. Access through operator[] and the iterators is in heap order, sorted() returns
+     *  the elements from the best one. The position of the best element is kept up to date by the sift
+     *  operations, so top() is O(1) as well as worst().
+     *
+     *  @tparam T          Type of the elements to store
+     *  @tparam comparator Elements comparator, it must implement "bool operator(const T& lhs, const T& rhs)",
+     *                     that returns true if lhs is better than rhs
+     */
+    template<typename T, typename comparator = std::greater<T>>
+        requires requires(T el, T el2, comparator comp) { comp(el, el2); }
+    class HeapBestSet {
+    public:
+        using value_type = T;
+        using size_type = typename std::vector<T>::size_type;
+        using reference = typename std::vector<T>::reference;
+        using const_reference = typename std::vector<T>::const_reference;
+        using pointer = typename std::vector<T>::pointer;
+        using const_pointer = typename std::vector<T>::const_pointer;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+        /// @name (constructors)
+        /// @{
+
+        /// @param capacity The capacity of the set
+        /// @param c        The comparator
+        explicit HeapBestSet(size_type capacity, comparator c = comparator()) : capacity_(capacity), c_(c) { elements_.reserve(capacity); }
+
+        HeapBestSet(const HeapBestSet &other) = default;
+        HeapBestSet(HeapBestSet &&other) noexcept = default;
+        HeapBestSet &operator=(const HeapBestSet &other) = default;
+        HeapBestSet &operator=(HeapBestSet &&other) noexcept = default;
+        /// @}
+
+        /// @return The current size of the set
+        [[nodiscard]] size_type size() const noexcept { return elements_.size(); }
+
+        /// @return The maximum number of elements
+        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+        /// @return True if the container is empty
+        [[nodiscard]] bool empty() const noexcept { return elements_.empty(); }
+
+        /// @return True if the set has reached its capacity
+        [[nodiscard]] bool full() const noexcept { return elements_.size() >= capacity_; }
+
+        /// @name Aggiunta elementi
+        /// @{
+
+        /// @brief Tells in O(1) whether add() would insert an element
+        [[nodiscard]] bool accepts(const value_type &element) const {
+            return !full() || (capacity_ > 0 && c_(element, elements_.front()));
+        }
+
+        /** @brief Adds an element in O(log k)
+         *
+         *  If the set is full, the element replaces the worst one only if it is better.
+         *
+         *  @param element The element to insert
+         *  @return true if the element has been inserted
+         */
+        bool add(const value_type &element) { return emplace(element); }
+
+        bool add(value_type &&element) { return emplace(std::move(element)); }
+
+        /// @brief Adds all the elements of another set, in O(m log k)
+        void merge(const HeapBestSet &other) {
+            for (const auto &element : other.elements_) {
+                add(element);
+            }
+        }
+
+        void merge(HeapBestSet &&other) {
+            for (auto &element : other.elements_) {
+                add(std::move(element));
+            }
+            other.elements_.clear();
+        }
+        /// @}
+
+        /// @name Accesso
+        /// @{
+
+        /// @brief Accesses an element in heap order
+        const value_type &operator[](size_type i) const { return elements_[i]; }
+
+        const value_type &at(size_type i) const { return elements_.at(i); }
+
+        /// @brief The best element, in O(1)
+        const value_type &top() const { return elements_[best_]; }
+
+        /// @brief The worst element, in O(1): an element not better than this is rejected when the set is full
+        const value_type &worst() const { return elements_.front(); }
+
+        /** @brief Extracts an element
+         *
+         *  O(log k), plus O(k) to find the new best element when the best one is extracted.
+         *
+         *  @param i Heap position of the element, the best one by default
+         *  @return The extracted element
+         */
+        value_type pop(size_type i) {
+            value_type ret(std::move(elements_[i]));
+            bool removed_best = i == best_;
+
+            auto last = elements_.size() - 1;
+            if (i != last) {
+                elements_[i] = std::move(elements_[last]);
+                if (best_ == last) {
+                    best_ = i;
+                }
+            }
+            elements_.pop_back();
+
+            if (i < elements_.size()) {
+                if (i > 0 && c_(elements_[parent(i)], elements_[i])) {
+                    sift_up(i);
+                } else {
+                    sift_down(i);
+                }
+            }
+            if (removed_best) {
+                find_best();
+            }
+            return ret;
+        }
+
+        value_type pop() { return pop(best_); }
+
+        /// @return The elements sorted from the best one, in O(k log k)
+        [[nodiscard]] std::vector<value_type> sorted() const {
+            auto ret = elements_;
+            std::sort(ret.begin(), ret.end(), c_);
+            return ret;
+        }
+        /// @}
+
+        /// @name Iteratori
+        /// @{
+
+        /// @brief Iteratore costante al primo elmento, in ordine di heap
+        const_iterator cbegin() const { return elements_.cbegin(); }
+
+        const_iterator begin() const { return cbegin(); }
+
+        const_iterator cend() const { return elements_.cend(); }
+
+        const_iterator end() const { return cend(); }
+        /// @}
+
+        friend std::ostream &operator<<(std::ostream &out, const HeapBestSet &bs) {
+            out << '[';
+            join_and_print(bs.sorted(), out);
+            return out << ']';
+        }
+
+    private:
+        static size_type parent(size_type i) { return (i - 1) / 2; }
+
+        template<class U>
+        bool emplace(U &&element) {
+            if (elements_.size() < capacity_) {
+                elements_.push_back(std::forward<U>(element));
+                auto i = elements_.size() - 1;
+                if (i == 0 || c_(elements_[i], elements_[best_])) {
+                    best_ = i;
+                }
+                sift_up(i);
+                return true;
+            }
+
+            if (!accepts(element)) {
+                return false;
+            }
+
+            // Il nuovo elemento prende il posto del peggiore
+            elements_.front() = std::forward<U>(element);
+            if (best_ == 0 || c_(elements_.front(), elements_[best_])) {
+                best_ = 0;
+            }
+            sift_down(0);
+            return true;
+        }
+
+        /// Moves the element in position i towards the root while it is worse than its parent
+        void sift_up(size_type i) {
+            bool is_best = i == best_;
+            value_type moving(std::move(elements_[i]));
+            while (i > 0) {
+                auto p = parent(i);
+                if (!c_(elements_[p], moving)) {
+                    break;
+                }
+                elements_[i] = std::move(elements_[p]);
+                if (best_ == p) {
+                    best_ = i;
+                }
+                i = p;
+            }
+            elements_[i] = std::move(moving);
+            if (is_best) {
+                best_ = i;
+            }
+        }
+
+        /// Moves the element in position i towards the leaves while it is better than its worst child
+        void sift_down(size_type i) {
+            bool is_best = i == best_;
+            value_type moving(std::move(elements_[i]));
+            auto n = elements_.size();
+            while (true) {
+                auto child = 2 * i + 1;
+                if (child >= n) {
+                    break;
+                }
+                if (child + 1 < n && c_(elements_[child], elements_[child + 1])) {
+                    ++child;
+                }
+                if (!c_(moving, elements_[child])) {
+                    break;
+                }
+                elements_[i] = std::move(elements_[child]);
+                if (best_ == child) {
+                    best_ = i;
+                }
+                i = child;
+            }
+            elements_[i] = std::move(moving);
+            if (is_best) {
+                best_ = i;
+            }
+        }
+
+        /// The best element is always a leaf
+        void find_best() {
+            best_ = elements_.size() / 2;
+            for (auto i = best_ + 1; i < elements_.size(); ++i) {
+                if (c_(elements_[i], elements_[best_])) {
+                    best_ = i;
+                }
+            }
+        }
+
+        /// Capacità massima dell'insieme
+        size_type capacity_;
+
+        /// Heap con il peggiore elemento in radice
+        std::vector<T> elements_;
+
+        /// Posizione del miglior elemento
+        size_type best_{0};
+
+        /// Serve a paragonare gli elementi
+        comparator c_;
+    };
+
+} // namespace dferone::containers
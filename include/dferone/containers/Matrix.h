@@ -4,49 +4,157 @@
 
 #pragma once
 
+#include "AlignedBuffer.h"
+#include <algorithm>
 #include <cassert>
+#include <concepts>
 #include <cstddef>
+#include <span>
+#include <utility>
 
 namespace dferone::containers {
 
-    template<class T>
+    /** @brief Dense row-major matrix stored in a single 64-byte aligned buffer
+     *
+     *  Rows can optionally be padded so that each one starts on a cache line, which
+     *  allows aligned SIMD loads over a whole row.
+     *
+     *  @tparam T       Type of the elements
+     *  @tparam Storage Storage of the elements; with a read-only storage (e.g. MappedBuffer) only the const methods are available
+     */
+    template<class T, class Storage = AlignedBuffer<T>>
     class Matrix {
+        /// Whether the elements can be modified
+        static constexpr bool writable = requires(Storage &s) {
+            { s.data() } -> std::same_as<T *>;
+        };
+
     public:
         Matrix() = default;
-        Matrix(std::size_t rows, std::size_t cols, const T &initializer = T()) { reset(rows, cols, initializer); }
 
-        void reset(std::size_t rows, std::size_t cols, const T &initializer = T()) {
+        /** @brief Builds a matrix on an existing storage
+         *
+         *  @param rows   Number of rows
+         *  @param cols   Number of columns
+         *  @param ld     Distance between the first elements of two consecutive rows
+         *  @param storage Storage holding at least rows * ld elements
+         */
+        Matrix(std::size_t rows, std::size_t cols, std::size_t ld, Storage storage) : rows_(rows), cols_(cols), ld_(ld), data_(std::move(storage)) {}
+
+        /** @param rows        Number of rows
+         *  @param cols        Number of columns
+         *  @param initializer Value of all the elements
+         *  @param padded      Whether the rows must be padded to a multiple of 64 bytes
+         */
+        Matrix(std::size_t rows, std::size_t cols, const T &initializer = T(), bool padded = false)
+            requires writable
+        {
+            reset(rows, cols, initializer, padded);
+        }
+
+        /// @brief Builds a matrix whose elements are going to be overwritten, without initialising them
+        Matrix(std::size_t rows, std::size_t cols, for_overwrite_t, bool padded = false)
+            requires writable
+        {
+            reset(rows, cols, for_overwrite, padded);
+        }
+
+        Matrix(const Matrix &other) = default;
+        Matrix(Matrix &&other) noexcept
+            : rows_(std::exchange(other.rows_, 0)), cols_(std::exchange(other.cols_, 0)), ld_(std::exchange(other.ld_, 0)), data_(std::move(other.data_)) {}
+
+        Matrix &operator=(const Matrix &other) = default;
+        Matrix &operator=(Matrix &&other) noexcept {
+            rows_ = std::exchange(other.rows_, 0);
+            cols_ = std::exchange(other.cols_, 0);
+            ld_ = std::exchange(other.ld_, 0);
+            data_ = std::move(other.data_);
+            return *this;
+        }
+
+        virtual ~Matrix() = default;
+
+        /** @brief Changes the size of the matrix and sets all the elements to initializer
+         *
+         *  The buffer is reused if it is large enough.
+         */
+        void reset(std::size_t rows, std::size_t cols, const T &initializer = T(), bool padded = false)
+            requires writable
+        {
+            reset(rows, cols, for_overwrite, padded);
+            std::fill_n(data_.data(), rows_ * ld_, initializer);
+        }
+
+        /** @brief Changes the size of the matrix without initialising the elements
+         *
+         *  This is O(1) when the buffer is large enough, and for trivial types otherwise.
+         */
+        void reset(std::size_t rows, std::size_t cols, for_overwrite_t, bool padded = false)
+            requires writable
+        {
             rows_ = rows;
             cols_ = cols;
-            std::size_t size = rows_ * cols_ * sizeof(T);
-            data_ = new T[size];
-            for (uint i = 0; i < rows_; ++i) {
-                for (uint j = 0; j < cols_; ++j) {
-                    this->operator()(i, j) = initializer;
-                }
-            }
+            ld_ = padded ? padded_cols(cols) : cols;
+            data_.reserve(rows_ * ld_);
         }
 
-        virtual ~Matrix() { delete[] data_; }
-
         const T &operator()(std::size_t row, std::size_t col) const {
             assert(row < rows_);
             assert(col < cols_);
 
-            return data_[row][col];
+            return data_.data()[ld_ * row + col];
         }
 
-        T &operator()(std::size_t row, std::size_t col) {
+        T &operator()(std::size_t row, std::size_t col)
+            requires writable
+        {
             assert(row < rows_);
             assert(col < cols_);
 
-            return data_[cols_ * row + col];
+            return data_.data()[ld_ * row + col];
         }
 
+        /// @return The elements of a row
+        std::span<const T> row(std::size_t row) const {
+            assert(row < rows_);
+            return {data_.data() + ld_ * row, cols_};
+        }
+
+        std::span<T> row(std::size_t row)
+            requires writable
+        {
+            assert(row < rows_);
+            return {data_.data() + ld_ * row, cols_};
+        }
+
+        /// @return The number of rows
+        [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+
+        /// @return The number of columns
+        [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+
+        /// @return The distance between the first elements of two consecutive rows (cols() unless padded)
+        [[nodiscard]] std::size_t leading_dimension() const noexcept { return ld_; }
+
+        /// @return Pointer to the first element, rows are leading_dimension() elements apart
+        T *data() noexcept
+            requires writable
+        {
+            return data_.data();
+        }
+        const T *data() const noexcept { return data_.data(); }
+
     private:
+        /// Rounds cols up so that a row spans a multiple of 64 bytes (when the size of T allows it)
+        static std::size_t padded_cols(std::size_t cols) {
+            constexpr std::size_t lanes = std::max<std::size_t>(1, 64 / sizeof(T));
+            return (cols + lanes - 1) / lanes * lanes;
+        }
+
         std::size_t rows_{0};
         std::size_t cols_{0};
-        T *data_{nullptr};
+        std::size_t ld_{0};
+        Storage data_;
     };
 
 } // namespace dferone::containers
@@ -0,0 +1,272 @@
+#pragma once
+
+#include "Matrix.h"
+#include "SymmetricMatrix.h"
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DFERONE_HAS_MMAP 1
+#endif
+
+/** @file MatrixFile.h
+ *  @brief Binary files holding a Matrix or a SymmetricMatrix, which can be memory-mapped
+ *
+ *  A file is made of a 64-byte MatrixFileHeader followed by the elements, stored exactly as in memory
+ *  (native endianness, rows leading_dimension elements apart, or packed for symmetric matrices).
+ *  Mapping a file read-only lets all the processes on a host share the same pages of the page cache.
+ */
+namespace dferone::containers {
+
+    /// @brief How the elements are laid out in a matrix file
+    enum class MatrixLayout : std::uint32_t { Dense = 0, PackedLower = 1, PackedUpper = 2 };
+
+    /// @brief Header of a matrix file
+    struct MatrixFileHeader {
+        /// Identifies the format
+        static constexpr char expected_magic[8] = {'D', 'F', 'M', 'A', 'T', 'R', 'I', 'X'};
+        static constexpr std::uint32_t current_version = 1;
+
+        char magic[8];
+        std::uint32_t version;
+        MatrixLayout layout;
+        /// Code of the element type (see element_type_code), 0 for other trivially copyable types
+        std::uint32_t element_type;
+        std::uint32_t element_size;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t leading_dimension;
+        /// Offset of the first element from the beginning of the file
+        std::uint64_t payload_offset;
+        char padding[8];
+    };
+    static_assert(sizeof(MatrixFileHeader) == 64);
+
+    namespace detail {
+        template<class T>
+        constexpr std::uint32_t element_type_code() {
+            if constexpr (std::is_same_v<T, float>) {
+                return 1;
+            } else if constexpr (std::is_same_v<T, double>) {
+                return 2;
+            } else if constexpr (std::is_integral_v<T>) {
+                // 16 + 2 * log2(size) + signedness, e.g. 22 for std::int32_t
+                return 16 + 2 * static_cast<std::uint32_t>(std::bit_width(sizeof(T)) - 1) + (std::is_signed_v<T> ? 1 : 0);
+            } else {
+                return 0;
+            }
+        }
+
+        template<class T>
+        MatrixFileHeader make_header(MatrixLayout layout, std::uint64_t rows, std::uint64_t cols, std::uint64_t ld) {
+            MatrixFileHeader header{};
+            std::memcpy(header.magic, MatrixFileHeader::expected_magic, sizeof(header.magic));
+            header.version = MatrixFileHeader::current_version;
+            header.layout = layout;
+            header.element_type = element_type_code<T>();
+            header.element_size = sizeof(T);
+            header.rows = rows;
+            header.cols = cols;
+            header.leading_dimension = ld;
+            header.payload_offset = sizeof(MatrixFileHeader);
+            return header;
+        }
+
+        template<class T>
+        void write_file(const std::string &path, const MatrixFileHeader &header, const T *data, std::size_t size) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot open " + path + " for writing!");
+            }
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size * sizeof(T)));
+            if (!out) {
+                throw std::runtime_error("Error writing " + path + "!");
+            }
+        }
+    } // namespace detail
+
+    /** @brief Writes a matrix to a file that can be mapped with map_matrix()
+     *
+     *  @param path Path of the file, overwritten if it exists
+     *  @param m    Matrix to write
+     */
+    template<class T, class Storage>
+        requires std::is_trivially_copyable_v<T>
+    void write_matrix(const std::string &path, const Matrix<T, Storage> &m) {
+        auto header = detail::make_header<T>(MatrixLayout::Dense, m.rows(), m.cols(), m.leading_dimension());
+        detail::write_file(path, header, m.data(), m.rows() * m.leading_dimension());
+    }
+
+    /** @brief Writes a symmetric matrix to a file that can be mapped with map_symmetric_matrix()
+     *
+     *  @param path Path of the file, overwritten if it exists
+     *  @param m    Matrix to write
+     */
+    template<class T, Triangle triangle, class Storage>
+        requires std::is_trivially_copyable_v<T>
+    void write_matrix(const std::string &path, const SymmetricMatrix<T, triangle, Storage> &m) {
+        auto layout = triangle == Triangle::Lower ? MatrixLayout::PackedLower : MatrixLayout::PackedUpper;
+        auto header = detail::make_header<T>(layout, m.rows(), m.rows(), 0);
+        detail::write_file(path, header, m.data(), m.packed_size());
+    }
+
+#ifdef DFERONE_HAS_MMAP
+
+    /** @brief Read-only storage for Matrix and SymmetricMatrix, backed by a memory-mapped matrix file
+     *
+     *  @tparam T Type of the elements
+     */
+    template<class T>
+        requires std::is_trivially_copyable_v<T>
+    class MappedBuffer {
+    public:
+        /** @brief Maps a matrix file
+         *
+         *  @param path Path of the file
+         */
+        explicit MappedBuffer(const std::string &path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+            }
+
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                auto error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+            }
+            length_ = static_cast<std::size_t>(st.st_size);
+            if (length_ < sizeof(MatrixFileHeader)) {
+                ::close(fd);
+                throw std::runtime_error(path + " is not a matrix file!");
+            }
+
+            auto *address = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+            auto error = errno;
+            ::close(fd);
+            if (address == MAP_FAILED) {
+                throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+            }
+            base_ = address;
+
+            std::memcpy(&header_, base_, sizeof(header_));
+            if (std::memcmp(header_.magic, MatrixFileHeader::expected_magic, sizeof(header_.magic)) != 0 ||
+                header_.version != MatrixFileHeader::current_version || header_.payload_offset > length_ ||
+                header_.payload_offset % alignof(T) != 0) {
+                release();
+                throw std::runtime_error(path + " is not a matrix file!");
+            }
+            if (header_.element_size != sizeof(T) || header_.element_type != detail::element_type_code<T>()) {
+                release();
+                throw std::runtime_error(path + " holds elements of a different type!");
+            }
+        }
+
+        MappedBuffer(const MappedBuffer &) = delete;
+        MappedBuffer &operator=(const MappedBuffer &) = delete;
+
+        MappedBuffer(MappedBuffer &&other) noexcept
+            : base_(std::exchange(other.base_, nullptr)), length_(std::exchange(other.length_, 0)), header_(other.header_) {}
+
+        MappedBuffer &operator=(MappedBuffer &&other) noexcept {
+            if (this != &other) {
+                release();
+                base_ = std::exchange(other.base_, nullptr);
+                length_ = std::exchange(other.length_, 0);
+                header_ = other.header_;
+            }
+            return *this;
+        }
+
+        ~MappedBuffer() { release(); }
+
+        /// @return Pointer to the first element
+        [[nodiscard]] const T *data() const noexcept {
+            return reinterpret_cast<const T *>(static_cast<const char *>(base_) + header_.payload_offset);
+        }
+
+        /// @return The number of elements in the file
+        [[nodiscard]] std::size_t capacity() const noexcept { return (length_ - header_.payload_offset) / sizeof(T); }
+
+        /// @return The header of the file
+        [[nodiscard]] const MatrixFileHeader &header() const noexcept { return header_; }
+
+    private:
+        void release() noexcept {
+            if (base_) {
+                ::munmap(base_, length_);
+            }
+            base_ = nullptr;
+            length_ = 0;
+        }
+
+        void *base_{nullptr};
+        std::size_t length_{0};
+        MatrixFileHeader header_{};
+    };
+
+    /// @brief Read-only matrix mapped from a file
+    template<class T>
+    using MappedMatrix = Matrix<T, MappedBuffer<T>>;
+
+    /// @brief Read-only symmetric matrix mapped from a file
+    template<class T, Triangle triangle = Triangle::Lower>
+    using MappedSymmetricMatrix = SymmetricMatrix<T, triangle, MappedBuffer<T>>;
+
+    /** @brief Maps a file written by write_matrix(const std::string &, const Matrix &)
+     *
+     *  @param path Path of the file
+     *  @return A read-only matrix whose elements are read from the page cache
+     */
+    template<class T>
+    MappedMatrix<T> map_matrix(const std::string &path) {
+        MappedBuffer<T> buffer(path);
+        const auto &header = buffer.header();
+        if (header.layout != MatrixLayout::Dense) {
+            throw std::runtime_error(path + " does not hold a dense matrix!");
+        }
+        if (header.cols > header.leading_dimension) {
+            throw std::runtime_error(path + " is not a matrix file!");
+        }
+        if (header.leading_dimension != 0 && header.rows > buffer.capacity() / header.leading_dimension) {
+            throw std::runtime_error(path + " is truncated!");
+        }
+        return MappedMatrix<T>(header.rows, header.cols, header.leading_dimension, std::move(buffer));
+    }
+
+    /** @brief Maps a file written by write_matrix(const std::string &, const SymmetricMatrix &)
+     *
+     *  @param path Path of the file
+     *  @return A read-only symmetric matrix whose elements are read from the page cache
+     */
+    template<class T, Triangle triangle = Triangle::Lower>
+    MappedSymmetricMatrix<T, triangle> map_symmetric_matrix(const std::string &path) {
+        MappedBuffer<T> buffer(path);
+        const auto &header = buffer.header();
+        if (header.layout != (triangle == Triangle::Lower ? MatrixLayout::PackedLower : MatrixLayout::PackedUpper)) {
+            throw std::runtime_error(path + " does not hold a symmetric matrix with the requested triangle!");
+        }
+        if (header.rows * (header.rows + 1) / 2 > buffer.capacity()) {
+            throw std::runtime_error(path + " is truncated!");
+        }
+        return MappedSymmetricMatrix<T, triangle>(header.rows, std::move(buffer));
+    }
+
+#endif
+
+} // namespace dferone::containers
@@ -9,7 +9,11 @@
 #define DF_SORTED_VECTOR_H_
 
 #include "containers.h"
+#include <algorithm>
+#include <cassert>
 #include <functional>
+#include <iterator>
+#include <ranges>
 #include <vector>
 
 namespace dferone::containers {
@@ -30,6 +34,12 @@ namespace dferone::containers {
 
         explicit SortedVector(comparator c = comparator()) : c_(c) {};
 
+        /// @brief Builds the vector from an unsorted range, in O(n log n)
+        template<std::ranges::input_range Range>
+        explicit SortedVector(const Range &r, comparator c = comparator()) : elements_(std::ranges::begin(r), std::ranges::end(r)), c_(c) {
+            std::sort(elements_.begin(), elements_.end(), c_);
+        }
+
         /// @brief Copy constructor
         SortedVector(const SortedVector &other) = default;
 
@@ -40,6 +50,12 @@ namespace dferone::containers {
         /// \return The current size of the set
         inline size_type size() const { return elements_.size(); }
 
+        /// @brief Makes room for n elements, so that the following insertions do not reallocate
+        inline void reserve(size_type n) { elements_.reserve(n); }
+
+        /// \return The number of elements that can be held without reallocating
+        inline size_type capacity() const { return elements_.capacity(); }
+
         /// @name Aggiunta elementi
         /// @{
 
@@ -52,6 +68,62 @@ namespace dferone::containers {
             auto it = std::lower_bound(elements_.begin(), elements_.end(), element, c_);
             return elements_.insert(it, std::move(element));
         }
+
+        /** @brief Adds many elements at once
+         *
+         *  The new elements are appended, sorted and merged with the old ones, which costs
+         *  O(m log m + n) instead of the O(m n) moves of m calls to add().
+         *
+         *  @param r The elements to add, in any order
+         */
+        template<std::ranges::input_range Range>
+        void insert_range(Range &&r) {
+            auto old_size = static_cast<typename std::vector<T>::difference_type>(elements_.size());
+            if constexpr (std::ranges::sized_range<Range>) {
+                elements_.reserve(elements_.size() + std::ranges::size(r));
+            }
+            for (auto &&element : r) {
+                elements_.push_back(std::forward<decltype(element)>(element));
+            }
+            auto middle = elements_.begin() + old_size;
+            std::sort(middle, elements_.end(), c_);
+            std::inplace_merge(elements_.begin(), middle, elements_.end(), c_);
+        }
+
+        /// @brief Synonym of insert_range()
+        template<std::ranges::input_range Range>
+        inline void add_bulk(Range &&r) {
+            insert_range(std::forward<Range>(r));
+        }
+        /// @}
+
+        /// @name Ricerca
+        /// Binary searches are branchless: the range halves at every step whatever the comparison says,
+        /// and the comparison only selects the half with a conditional move. On vectors larger than the L1 cache
+        /// both candidates for the next probe are prefetched, so the load is not waited for at every step
+        /// @{
+
+        /// @return Iterator to the first element not less than value
+        inline const_iterator lower_bound(const value_type &value) const {
+            return search(value, [this](const value_type &element, const value_type &v) { return c_(element, v); });
+        }
+
+        /// @return Iterator to the first element greater than value
+        inline const_iterator upper_bound(const value_type &value) const {
+            return search(value, [this](const value_type &element, const value_type &v) { return !c_(v, element); });
+        }
+
+        /// @return Iterator to an element equivalent to value, or end()
+        inline const_iterator find(const value_type &value) const {
+            auto it = lower_bound(value);
+            return it != end() && !c_(value, *it) ? it : end();
+        }
+
+        /// @return true if the vector contains an element equivalent to value
+        inline bool contains(const value_type &value) const { return find(value) != end(); }
+
+        /// @return The number of elements equivalent to value
+        inline size_type count(const value_type &value) const { return static_cast<size_type>(upper_bound(value) - lower_bound(value)); }
         /// @}
 
         /// @name Accesso
@@ -73,6 +145,17 @@ namespace dferone::containers {
 
         inline auto erase(size_type i) { return elements_.erase(elements_.begin() + i); }
         inline auto erase(const_iterator it) { return elements_.erase(it); }
+        inline auto erase(const_iterator first, const_iterator last) { return elements_.erase(first, last); }
+
+        /** @brief Removes all the elements satisfying a predicate, compacting the vector in a single pass
+         *
+         *  @param pred The predicate
+         *  @return The number of removed elements
+         */
+        template<class Predicate>
+        inline size_type erase_if(Predicate pred) {
+            return static_cast<size_type>(std::erase_if(elements_, pred));
+        }
         /// @}
 
         /// @name Iteratori
@@ -100,6 +183,37 @@ namespace dferone::containers {
         inline bool empty() const { return elements_.empty(); }
 
     private:
+        /// Branchless binary search of the first element for which before(element, value) is false
+        template<class Before>
+        inline const_iterator search(const value_type &value, Before before) const {
+            auto n = elements_.size();
+            if (n == 0) {
+                return end();
+            }
+            const auto *base = n * sizeof(T) > prefetch_bytes ? descend<true>(elements_.data(), n, value, before)
+                                                              : descend<false>(elements_.data(), n, value, before);
+            return begin() + ((base - elements_.data()) + before(*base, value));
+        }
+
+        /// Vectors up to this size stay in the L1 cache, where prefetching only adds work to every step
+        static constexpr size_type prefetch_bytes = 32 * 1024;
+
+        /// Halves [base, base + n) down to one element
+        template<bool prefetch, class Before>
+        static inline const T *descend(const T *base, size_type n, const value_type &value, Before before) {
+            while (n > 1) {
+                auto half = n / 2;
+                if constexpr (prefetch) {
+                    // The next probe is one of these two: the loads start before the comparison decides which
+                    __builtin_prefetch(base + half / 2);
+                    __builtin_prefetch(base + half + half / 2);
+                }
+                base = before(base[half], value) ? base + half : base;
+                n -= half;
+            }
+            return base;
+        }
+
         /// Conserva gli elementi
         std::vector<T> elements_;
 
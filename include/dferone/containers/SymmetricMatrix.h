@@ -4,47 +4,160 @@
 
 #pragma once
 
+#include "AlignedBuffer.h"
+#include <algorithm>
 #include <cassert>
+#include <concepts>
 #include <cstddef>
+#include <span>
+#include <utility>
 
 namespace dferone::containers {
 
-    template<class T>
+    /// @brief Which triangle of a SymmetricMatrix is stored
+    enum class Triangle {
+        /// Row i stores the columns [0, i]
+        Lower,
+        /// Row i stores the columns [i, n)
+        Upper
+    };
+
+    /** @brief Symmetric square matrix storing only one triangle, packed row by row
+     *
+     *  A n x n matrix takes n(n+1)/2 elements instead of n².
+     *
+     *  @tparam T        Type of the elements
+     *  @tparam triangle Triangle stored; it decides which part of each row is contiguous
+     *  @tparam Storage  Storage of the elements; with a read-only storage (e.g. MappedBuffer) only the const methods are available
+     */
+    template<class T, Triangle triangle = Triangle::Lower, class Storage = AlignedBuffer<T>>
     class SymmetricMatrix {
+        /// Whether the elements can be modified
+        static constexpr bool writable = requires(Storage &s) {
+            { s.data() } -> std::same_as<T *>;
+        };
+
     public:
         SymmetricMatrix() = default;
-        explicit SymmetricMatrix(std::size_t rows, const T &initializer = T()) { reset(rows, initializer); }
+        explicit SymmetricMatrix(std::size_t rows, const T &initializer = T())
+            requires writable
+        {
+            reset(rows, initializer);
+        }
+
+        /// @brief Builds a matrix whose elements are going to be overwritten, without initialising them
+        SymmetricMatrix(std::size_t rows, for_overwrite_t)
+            requires writable
+        {
+            reset(rows, for_overwrite);
+        }
+
+        /** @brief Builds a matrix on an existing storage
+         *
+         *  @param rows    Number of rows
+         *  @param storage Storage holding at least rows(rows+1)/2 elements, packed as specified by triangle
+         */
+        SymmetricMatrix(std::size_t rows, Storage storage) : n_(rows), data_(std::move(storage)) {}
+
+        SymmetricMatrix(const SymmetricMatrix &other) = default;
+        SymmetricMatrix(SymmetricMatrix &&other) noexcept : n_(std::exchange(other.n_, 0)), data_(std::move(other.data_)) {}
 
-        void reset(std::size_t rows, const T &initializer = T()) {
+        SymmetricMatrix &operator=(const SymmetricMatrix &other) = default;
+        SymmetricMatrix &operator=(SymmetricMatrix &&other) noexcept {
+            n_ = std::exchange(other.n_, 0);
+            data_ = std::move(other.data_);
+            return *this;
+        }
+
+        virtual ~SymmetricMatrix() = default;
+
+        /// @brief Changes the size of the matrix and sets all the elements to initializer
+        void reset(std::size_t rows, const T &initializer = T())
+            requires writable
+        {
+            reset(rows, for_overwrite);
+            std::fill_n(data_.data(), packed_size(), initializer);
+        }
+
+        /// @brief Changes the size of the matrix without initialising the elements (O(1) if the buffer is large enough)
+        void reset(std::size_t rows, for_overwrite_t)
+            requires writable
+        {
             n_ = rows;
-            std::size_t size = ((n_ * n_ + n_) / 2) * sizeof(T);
-            data_ = new T[size];
-            for (std::size_t i = 0; i < n_; ++i) {
-                for (std::size_t j = 0; j <= i; ++j) {
-                    this->operator()(i, j) = initializer;
-                }
-            }
+            data_.reserve(packed_size());
+        }
+
+        const T &operator()(std::size_t row, std::size_t col) const { return data_.data()[index(row, col)]; }
+
+        T &operator()(std::size_t row, std::size_t col)
+            requires writable
+        {
+            return data_.data()[index(row, col)];
         }
 
-        virtual ~SymmetricMatrix() { delete[] data_; }
+        /** @brief The contiguous part of a row
+         *
+         *  @return The columns [0, row] with Triangle::Lower, the columns [row, n) with Triangle::Upper
+         */
+        std::span<const T> packed_row(std::size_t row) const {
+            assert(row < n_);
+            return {data_.data() + row_offset(row), row_length(row)};
+        }
 
-        const T &operator()(std::size_t row, std::size_t col) const {
+        std::span<T> packed_row(std::size_t row)
+            requires writable
+        {
             assert(row < n_);
-            assert(col < n_);
+            return {data_.data() + row_offset(row), row_length(row)};
+        }
+
+        /// @return The number of rows (and columns)
+        [[nodiscard]] std::size_t rows() const noexcept { return n_; }
 
-            return (row <= col) ? data_[row * n_ + col] : data_[col * n_ + row];
+        /// @return The number of elements actually stored
+        [[nodiscard]] std::size_t packed_size() const noexcept { return n_ * (n_ + 1) / 2; }
+
+        /// @return Pointer to the first element of the packed storage
+        T *data() noexcept
+            requires writable
+        {
+            return data_.data();
         }
+        const T *data() const noexcept { return data_.data(); }
 
-        T &operator()(std::size_t row, std::size_t col) {
+    private:
+        /// Position of (row, col) in the packed storage; min and max compile to conditional moves
+        std::size_t index(std::size_t row, std::size_t col) const {
             assert(row < n_);
             assert(col < n_);
 
-            return (row <= col) ? data_[row * n_ + col] : data_[col * n_ + row];
+            auto lo = std::min(row, col);
+            auto hi = std::max(row, col);
+            if constexpr (triangle == Triangle::Lower) {
+                return hi * (hi + 1) / 2 + lo;
+            } else {
+                return row_offset(lo) + (hi - lo);
+            }
+        }
+
+        std::size_t row_offset(std::size_t row) const {
+            if constexpr (triangle == Triangle::Lower) {
+                return row * (row + 1) / 2;
+            } else {
+                return row * (2 * n_ - row + 1) / 2;
+            }
+        }
+
+        std::size_t row_length(std::size_t row) const {
+            if constexpr (triangle == Triangle::Lower) {
+                return row + 1;
+            } else {
+                return n_ - row;
+            }
         }
 
-    private:
         std::size_t n_{0};
-        T *data_{nullptr};
+        Storage data_;
     };
 
 } // namespace dferone::containers
@@ -2,11 +2,19 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
+#include <cmath>
 #include <concepts>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <random>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <unordered_set>
 #include <vector>
 
 namespace dferone::random {
@@ -45,18 +53,483 @@ namespace dferone::random {
         return std::mt19937_64(seq);
     }
 
+    // ============================================================
+    //  Small fast engines
+    // ============================================================
+
+    /// @brief SplitMix64: a 64-bit counter passed through a mixing function.
+    ///
+    /// Too weak for simulations on its own, it is the recommended way to expand
+    /// a single seed into the state of the other engines.
+    class SplitMix64 {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit SplitMix64(std::uint64_t seed = 0) : state_(seed) {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() { return mix(state_ += increment); }
+
+        /// @brief The mixing function: a bijection of 64-bit integers scattering nearby inputs.
+        static constexpr std::uint64_t mix(std::uint64_t z) {
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+    private:
+        static constexpr std::uint64_t increment = 0x9e3779b97f4a7c15ULL;
+
+        std::uint64_t state_;
+    };
+
+    /// @brief xoshiro256** by Blackman and Vigna: 32 bytes of state, period 2^256 - 1.
+    class Xoshiro256StarStar {
+    public:
+        using result_type = std::uint64_t;
+
+        /// @param seed Expanded into the state with SplitMix64
+        explicit Xoshiro256StarStar(std::uint64_t seed = 0) {
+            SplitMix64 sm(seed);
+            std::ranges::generate(s_, std::ref(sm));
+        }
+
+        /// @brief Seeds the engine from a seed sequence, like the standard engines.
+        template<class SeedSeq>
+            requires requires(SeedSeq &seq, std::uint32_t *out) { seq.generate(out, out); }
+        explicit Xoshiro256StarStar(SeedSeq &seq) {
+            std::array<std::uint32_t, 8> words{};
+            seq.generate(words.begin(), words.end());
+            for (std::size_t i = 0; i < s_.size(); ++i) {
+                s_[i] = (std::uint64_t{words[2 * i]} << 32) | words[2 * i + 1];
+            }
+            if (std::ranges::all_of(s_, [](auto x) { return x == 0; })) {
+                s_[0] = 1;
+            }
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            auto result = std::rotl(s_[1] * 5, 7) * 9;
+            auto t = s_[1] << 17;
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= t;
+            s_[3] = std::rotl(s_[3], 45);
+            return result;
+        }
+
+        /// @brief Advances the engine by 2^128 steps: the streams obtained by repeated jumps never overlap.
+        void jump() {
+            constexpr std::array<std::uint64_t, 4> polynomial{0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL,
+                                                              0x39abdc4529b1661cULL};
+            std::array<std::uint64_t, 4> t{};
+            for (auto word : polynomial) {
+                for (int b = 0; b < 64; ++b) {
+                    if (word & (std::uint64_t{1} << b)) {
+                        for (std::size_t i = 0; i < t.size(); ++i) {
+                            t[i] ^= s_[i];
+                        }
+                    }
+                    (*this)();
+                }
+            }
+            s_ = t;
+        }
+
+        /// @brief The state of the engine
+        [[nodiscard]] const std::array<std::uint64_t, 4> &state() const { return s_; }
+
+        bool operator==(const Xoshiro256StarStar &other) const = default;
+
+    private:
+        std::array<std::uint64_t, 4> s_;
+    };
+
+#ifdef __SIZEOF_INT128__
+    /// 128-bit unsigned integer (__extension__ keeps -Wpedantic quiet about it)
+    __extension__ typedef unsigned __int128 uint128_t;
+
+    /// @brief PCG64 (XSL-RR 128/64) by O'Neill: a 128-bit LCG with a permuted output, with 2^127 selectable streams.
+    class Pcg64 {
+    public:
+        using result_type = std::uint64_t;
+
+        /// @param seed   Starting point
+        /// @param stream Stream: engines with different streams produce independent sequences
+        explicit Pcg64(std::uint64_t seed = 0, std::uint64_t stream = 0) {
+            SplitMix64 sm(seed);
+            auto initial = (uint128_t{sm()} << 64) | sm();
+            seed_state(initial, (uint128_t{SplitMix64::mix(stream)} << 64) | stream);
+        }
+
+        /// @brief Seeds the engine from a seed sequence, like the standard engines: both the state and the stream are drawn from it.
+        template<class SeedSeq>
+            requires requires(SeedSeq &seq, std::uint32_t *out) { seq.generate(out, out); }
+        explicit Pcg64(SeedSeq &seq) {
+            std::array<std::uint32_t, 8> words{};
+            seq.generate(words.begin(), words.end());
+            auto join = [&](std::size_t i) {
+                return (uint128_t{words[i]} << 96) | (uint128_t{words[i + 1]} << 64) | (uint128_t{words[i + 2]} << 32) | words[i + 3];
+            };
+            seed_state(join(0), join(4));
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            step();
+            auto folded = static_cast<std::uint64_t>(state_ >> 64) ^ static_cast<std::uint64_t>(state_);
+            return std::rotr(folded, static_cast<int>(state_ >> 122));
+        }
+
+        bool operator==(const Pcg64 &other) const = default;
+
+    private:
+        static constexpr uint128_t multiplier = (uint128_t{0x2360ed051fc65da4ULL} << 64) | 0x4385df649fccf645ULL;
+
+        /// Standard PCG initialisation: the increment must be odd
+        void seed_state(uint128_t initial, uint128_t stream) {
+            increment_ = (stream << 1) | 1;
+            state_ = 0;
+            step();
+            state_ += initial;
+            step();
+        }
+
+        void step() { state_ = state_ * multiplier + increment_; }
+
+        uint128_t state_;
+        uint128_t increment_;
+    };
+#endif
+
+    // ============================================================
+    //  Bounded integers
+    // ============================================================
+
+    /// @brief Draws an integer uniformly in [0, range) with Lemire's nearly divisionless method.
+    ///
+    /// A random word is multiplied by range and the high half of the product is the result;
+    /// a division is only needed in the rare case the low half falls in the biased zone.
+    /// Engines not producing full 32 or 64-bit words fall back to std::uniform_int_distribution.
+    ///
+    /// @param rng   random generator
+    /// @param range number of possible values, greater than 0
+    template<URBG Rng>
+    std::uint64_t bounded_rand(Rng &rng, std::uint64_t range) {
+        assert(range > 0);
+        constexpr bool full_32 = Rng::min() == 0 && Rng::max() == std::numeric_limits<std::uint32_t>::max();
+        [[maybe_unused]] constexpr bool full_64 = Rng::min() == 0 && Rng::max() == std::numeric_limits<std::uint64_t>::max();
+
+        if constexpr (full_32) {
+            if (range <= std::numeric_limits<std::uint32_t>::max()) {
+                auto m = std::uint64_t{static_cast<std::uint32_t>(rng())} * range;
+                if (static_cast<std::uint32_t>(m) < range) {
+                    auto threshold = static_cast<std::uint32_t>(-static_cast<std::uint32_t>(range)) % static_cast<std::uint32_t>(range);
+                    while (static_cast<std::uint32_t>(m) < threshold) {
+                        m = std::uint64_t{static_cast<std::uint32_t>(rng())} * range;
+                    }
+                }
+                return m >> 32;
+            }
+        }
+#ifdef __SIZEOF_INT128__
+        if constexpr (full_64) {
+            auto m = uint128_t{static_cast<std::uint64_t>(rng())} * range;
+            if (static_cast<std::uint64_t>(m) < range) {
+                auto threshold = -range % range;
+                while (static_cast<std::uint64_t>(m) < threshold) {
+                    m = uint128_t{static_cast<std::uint64_t>(rng())} * range;
+                }
+            }
+            return static_cast<std::uint64_t>(m >> 64);
+        }
+#endif
+        return std::uniform_int_distribution<std::uint64_t>(0, range - 1)(rng);
+    }
+
+    /// @brief Draws an integer uniformly in [a, b] with bounded_rand().
+    template<std::integral Int, URBG Rng>
+    Int uniform_int(Rng &rng, Int a, Int b) {
+        assert(a <= b);
+        auto range = static_cast<std::uint64_t>(b) - static_cast<std::uint64_t>(a);
+        if (range == std::numeric_limits<std::uint64_t>::max()) {
+            return static_cast<Int>(static_cast<std::uint64_t>(rng()));
+        }
+        return static_cast<Int>(static_cast<std::uint64_t>(a) + bounded_rand(rng, range + 1));
+    }
+
+    // ============================================================
+    //  Batched generation
+    // ============================================================
+
+    /// @brief Several interleaved xoshiro256** engines, filling buffers a block of words at a time.
+    ///
+    /// The state is stored lane by lane, so the inner loop over the lanes has no dependencies
+    /// and is vectorised by the compiler (the multiplications by 5 and 9 are shifts and adds).
+    /// Lanes are separated by jumps of 2^128 steps, so their streams never overlap.
+    ///
+    /// @tparam lanes Number of interleaved engines
+    template<std::size_t lanes = 8>
+    class Xoshiro256StarStarBatch {
+    public:
+        explicit Xoshiro256StarStarBatch(std::uint64_t seed = 0) {
+            Xoshiro256StarStar engine(seed);
+            for (std::size_t l = 0; l < lanes; ++l) {
+                for (std::size_t i = 0; i < 4; ++i) {
+                    s_[i][l] = engine.state()[i];
+                }
+                engine.jump();
+            }
+        }
+
+        /// @brief Fills a buffer with random words
+        void fill(std::span<std::uint64_t> out) {
+            std::size_t i = 0;
+            for (; i + lanes <= out.size(); i += lanes) {
+                next(out.data() + i);
+            }
+            if (i < out.size()) {
+                std::array<std::uint64_t, lanes> tail{};
+                next(tail.data());
+                std::copy_n(tail.begin(), out.size() - i, out.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+
+        /// @brief Fills a buffer with doubles uniformly distributed in [0, 1)
+        void fill(std::span<double> out) {
+            std::array<std::uint64_t, lanes> block{};
+            for (std::size_t i = 0; i < out.size(); i += lanes) {
+                next(block.data());
+                for (std::size_t l = 0; l < lanes && i + l < out.size(); ++l) {
+                    out[i + l] = static_cast<double>(block[l] >> 11) * 0x1.0p-53;
+                }
+            }
+        }
+
+    private:
+        void next(std::uint64_t *out) {
+            auto &[s0, s1, s2, s3] = s_;
+            for (std::size_t l = 0; l < lanes; ++l) {
+                out[l] = std::rotl(s1[l] * 5, 7) * 9;
+                auto t = s1[l] << 17;
+                s2[l] ^= s0[l];
+                s3[l] ^= s1[l];
+                s1[l] ^= s2[l];
+                s0[l] ^= s3[l];
+                s2[l] ^= t;
+                s3[l] = std::rotl(s3[l], 45);
+            }
+        }
+
+        std::array<std::array<std::uint64_t, lanes>, 4> s_{};
+    };
+
+    /// @brief Draws a double uniformly in [0, 1), from a single word for 64-bit engines.
+    template<URBG Rng>
+    double unit_double(Rng &rng) {
+        if constexpr (Rng::min() == 0 && Rng::max() == std::numeric_limits<std::uint64_t>::max()) {
+            return static_cast<double>(static_cast<std::uint64_t>(rng()) >> 11) * 0x1.0p-53;
+        } else {
+            return std::generate_canonical<double, std::numeric_limits<double>::digits>(rng);
+        }
+    }
+
+    // ============================================================
+    //  Weighted selection
+    // ============================================================
+
+    /// @brief Draws indices with probability proportional to fixed weights in O(1), with Vose's alias method.
+    ///
+    /// Building the table costs O(n); every draw picks a column uniformly and then
+    /// either the column or its alias with a single comparison.
+    class AliasTable {
+    public:
+        /// @param weights Non-negative weights, not all zero
+        explicit AliasTable(std::span<const double> weights) : probability_(weights.size()), alias_(weights.size()) {
+            auto n = weights.size();
+            assert(n > 0);
+            auto total = std::accumulate(weights.begin(), weights.end(), 0.0);
+            assert(total > 0.0);
+
+            // Scaled weights: columns under 1 are filled up by a column over 1
+            std::vector<double> scaled(n);
+            std::vector<std::size_t> small;
+            std::vector<std::size_t> large;
+            for (std::size_t i = 0; i < n; ++i) {
+                scaled[i] = weights[i] * static_cast<double>(n) / total;
+                (scaled[i] < 1.0 ? small : large).push_back(i);
+            }
+            while (!small.empty() && !large.empty()) {
+                auto s = small.back();
+                auto l = large.back();
+                small.pop_back();
+                probability_[s] = scaled[s];
+                alias_[s] = l;
+                scaled[l] -= 1.0 - scaled[s];
+                if (scaled[l] < 1.0) {
+                    large.pop_back();
+                    small.push_back(l);
+                }
+            }
+            // What is left is 1 up to rounding errors
+            for (auto i : large) {
+                probability_[i] = 1.0;
+                alias_[i] = i;
+            }
+            for (auto i : small) {
+                probability_[i] = 1.0;
+                alias_[i] = i;
+            }
+        }
+
+        /// @return A random index
+        template<URBG Rng>
+        std::size_t operator()(Rng &rng) const {
+            auto column = static_cast<std::size_t>(bounded_rand(rng, probability_.size()));
+            return unit_double(rng) < probability_[column] ? column : alias_[column];
+        }
+
+        /// @return The number of weights
+        [[nodiscard]] std::size_t size() const { return probability_.size(); }
+
+    private:
+        std::vector<double> probability_;
+        std::vector<std::size_t> alias_;
+    };
+
+    /// @brief Draws indices with probability proportional to weights that can change, with a Fenwick tree.
+    ///
+    /// Updating a weight and drawing an index both cost O(log n): suited to a restricted candidate
+    /// list whose scores change, or whose elements are removed, after every pick.
+    class FenwickSampler {
+    public:
+        /// @param n Number of indices, all with weight 0
+        explicit FenwickSampler(std::size_t n) : weights_(n, 0.0), tree_(n + 1, 0.0) {}
+
+        /// @param weights Initial non-negative weights
+        explicit FenwickSampler(std::span<const double> weights) : weights_(weights.begin(), weights.end()), tree_(weights.size() + 1, 0.0) {
+            rebuild();
+        }
+
+        /// @brief Sets the weight of an index
+        void set(std::size_t i, double weight) {
+            assert(weight >= 0.0);
+            positive_ = positive_ - (weights_[i] > 0.0) + (weight > 0.0);
+            auto delta = weight - weights_[i];
+            weights_[i] = weight;
+            for (auto k = i + 1; k < tree_.size(); k += k & (~k + 1)) {
+                tree_[k] += delta;
+            }
+        }
+
+        /// @brief Excludes an index from the draws
+        void remove(std::size_t i) { set(i, 0.0); }
+
+        /// @return The weight of an index
+        [[nodiscard]] double weight(std::size_t i) const { return weights_[i]; }
+
+        /// @return The sum of the weights
+        [[nodiscard]] double total() const {
+            double sum = 0.0;
+            for (auto k = weights_.size(); k > 0; k -= k & (~k + 1)) {
+                sum += tree_[k];
+            }
+            return sum;
+        }
+
+        /// @return The number of indices
+        [[nodiscard]] std::size_t size() const { return weights_.size(); }
+
+        /// @return The number of indices with a positive weight, which can be drawn
+        [[nodiscard]] std::size_t positive() const { return positive_; }
+
+        /// @brief Recomputes the tree in O(n), clearing the rounding errors accumulated by many updates
+        void rebuild() {
+            positive_ = static_cast<std::size_t>(std::ranges::count_if(weights_, [](double w) { return w > 0.0; }));
+            std::fill(tree_.begin(), tree_.end(), 0.0);
+            for (std::size_t k = 1; k < tree_.size(); ++k) {
+                tree_[k] += weights_[k - 1];
+                auto parent = k + (k & (~k + 1));
+                if (parent < tree_.size()) {
+                    tree_[parent] += tree_[k];
+                }
+            }
+        }
+
+        /// @return A random index
+        /// @throws std::runtime_error if no weight is positive
+        template<URBG Rng>
+        std::size_t operator()(Rng &rng) const {
+            if (positive_ == 0) {
+                throw std::runtime_error("Drawing from a FenwickSampler without positive weights!");
+            }
+            for (int attempt = 0; attempt < max_draws; ++attempt) {
+                auto target = unit_double(rng) * total();
+                // Descends the implicit tree looking for the first prefix sum greater than target
+                std::size_t pos = 0;
+                for (auto step = std::bit_floor(weights_.size()); step > 0; step >>= 1) {
+                    if (pos + step < tree_.size() && tree_[pos + step] <= target) {
+                        pos += step;
+                        target -= tree_[pos];
+                    }
+                }
+                // Rounding errors can point past the last positive weight: draw again
+                if (pos < weights_.size() && weights_[pos] > 0.0) {
+                    return pos;
+                }
+            }
+            // The rounding errors of the tree outweigh the positive weights left: draw on the weights in O(n)
+            auto target = unit_double(rng) * std::accumulate(weights_.begin(), weights_.end(), 0.0);
+            std::size_t last = 0;
+            for (std::size_t i = 0; i < weights_.size(); ++i) {
+                if (weights_[i] > 0.0) {
+                    last = i;
+                    target -= weights_[i];
+                    if (target < 0.0) {
+                        break;
+                    }
+                }
+            }
+            return last;
+        }
+
+    private:
+        /// Draws on the tree before falling back to the weights
+        static constexpr int max_draws = 64;
+
+        std::vector<double> weights_;
+
+        /// Fenwick tree of the weights, 1-based
+        std::vector<double> tree_;
+
+        /// Number of positive weights
+        std::size_t positive_{0};
+    };
+
     // ============================================================
     //  Uniform random selection (from container or iterator)
     // ============================================================
 
     /// @brief Select a random element uniformly from a sized range.
+    ///
+    /// It draws with std::uniform_int_distribution, so that a fixed seed keeps selecting the same elements;
+    /// bounded_rand() is faster when that does not matter.
     /// @return Iterator to selected element.
     template<SizedRange Container, URBG Rng>
     auto random_select(const Container &c, Rng &rng) {
         assert(!c.empty());
         std::uniform_int_distribution<std::size_t> dis(0, c.size() - 1);
         auto it = std::ranges::cbegin(c);
-        std::advance(it, dis(rng));
+        std::advance(it, static_cast<std::iter_difference_t<decltype(it)>>(dis(rng)));
         return it;
     }
 
@@ -68,10 +541,104 @@ namespace dferone::random {
     It random_select(It it, const std::size_t size, Rng &rng) {
         assert(size > 0);
         std::uniform_int_distribution<std::size_t> dis(0, size - 1);
-        std::advance(it, dis(rng));
+        std::advance(it, static_cast<std::iter_difference_t<It>>(dis(rng)));
         return it;
     }
 
+    // ============================================================
+    //  Sampling without replacement
+    // ============================================================
+
+    /// @brief Moves a uniform sample of k elements to the front of [first, last), with a partial Fisher–Yates pass.
+    ///
+    /// Only the first k positions are drawn, so it costs O(k); the sample is in random order.
+    template<std::random_access_iterator It, URBG Rng>
+    void partial_shuffle(It first, It last, std::size_t k, Rng &rng) {
+        auto n = static_cast<std::size_t>(last - first);
+        assert(k <= n);
+        for (std::size_t i = 0; i < k; ++i) {
+            auto j = i + static_cast<std::size_t>(bounded_rand(rng, n - i));
+            using std::swap;
+            swap(first[static_cast<std::ptrdiff_t>(i)], first[static_cast<std::ptrdiff_t>(j)]);
+        }
+    }
+
+    /// @brief Select k distinct elements uniformly from a random-access range.
+    ///
+    /// Small samples use Floyd's algorithm, which draws exactly k indices and needs O(k) memory;
+    /// large ones a partial Fisher–Yates pass over the indices. The elements are in no particular order.
+    ///
+    /// @return The selected elements
+    template<std::ranges::random_access_range Container, URBG Rng>
+        requires std::ranges::sized_range<Container>
+    auto sample_k(const Container &c, std::size_t k, Rng &rng) {
+        using value_type = std::ranges::range_value_t<Container>;
+        auto n = static_cast<std::size_t>(std::ranges::size(c));
+        assert(k <= n);
+        auto first = std::ranges::cbegin(c);
+
+        std::vector<value_type> ret;
+        ret.reserve(k);
+        if (4 * k >= n) {
+            std::vector<std::size_t> indices(n);
+            std::iota(indices.begin(), indices.end(), std::size_t{0});
+            partial_shuffle(indices.begin(), indices.end(), k, rng);
+            for (std::size_t i = 0; i < k; ++i) {
+                ret.push_back(first[static_cast<std::ptrdiff_t>(indices[i])]);
+            }
+            return ret;
+        }
+
+        // Floyd: for j = n - k, ..., n - 1 pick t in [0, j], or j itself if t was already picked
+        std::unordered_set<std::size_t> picked;
+        picked.reserve(2 * k);
+        for (auto j = n - k; j < n; ++j) {
+            auto t = static_cast<std::size_t>(bounded_rand(rng, j + 1));
+            auto index = picked.insert(t).second ? t : j;
+            picked.insert(index);
+            ret.push_back(first[static_cast<std::ptrdiff_t>(index)]);
+        }
+        return ret;
+    }
+
+    /// @brief Select k elements uniformly from an input range whose size is not known in advance (reservoir sampling).
+    ///
+    /// Li's Algorithm L jumps over the elements that do not enter the reservoir, so it draws
+    /// O(k log(n / k)) random numbers instead of one per element.
+    ///
+    /// @return The selected elements, fewer than k if the range is shorter
+    template<std::ranges::input_range Range, URBG Rng>
+    auto reservoir_sample(Range &&r, std::size_t k, Rng &rng) {
+        std::vector<std::ranges::range_value_t<Range>> reservoir;
+        if (k == 0) {
+            return reservoir;
+        }
+        reservoir.reserve(k);
+
+        auto it = std::ranges::begin(r);
+        auto end = std::ranges::end(r);
+        for (; it != end && reservoir.size() < k; ++it) {
+            reservoir.push_back(*it);
+        }
+
+        // Log of a uniform number in (0, 1]
+        auto log_unit = [&rng]() { return std::log(1.0 - unit_double(rng)); };
+        auto w = std::exp(log_unit() / static_cast<double>(k));
+        while (it != end) {
+            auto skip = std::floor(log_unit() / std::log1p(-w));
+            for (; skip > 0 && it != end; skip -= 1.0) {
+                ++it;
+            }
+            if (it == end) {
+                break;
+            }
+            reservoir[static_cast<std::size_t>(bounded_rand(rng, k))] = *it;
+            ++it;
+            w *= std::exp(log_unit() / static_cast<double>(k));
+        }
+        return reservoir;
+    }
+
     // ============================================================
     //  Geometric selection
     // ============================================================
@@ -4,7 +4,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace dferone {
 
@@ -19,8 +32,82 @@ namespace dferone {
             mean_ += delta / static_cast<double>(count_);
             double delta2 = x - mean_;
             sum_of_squares_ += delta * delta2;
+            min_ = std::min(min_, x);
+            max_ = std::max(max_, x);
         }
 
+        /// \brief Add a batch of values
+        ///
+        /// The batch is summarised with two passes and then merged with the values added so far.
+        /// Without -ffast-math the compiler cannot reorder a single floating-point sum, so the sums are
+        /// split across lanes independent accumulators, which it can hold in a vector register.
+        /// \param xs Values to add
+        void addElements(std::span<const double> xs) {
+            if (xs.empty()) {
+                return;
+            }
+
+            std::array<double, lanes> sum{};
+            std::array<double, lanes> min;
+            std::array<double, lanes> max;
+            min.fill(xs[0]);
+            max.fill(xs[0]);
+            auto tail = xs.size() - xs.size() % lanes;
+            for (std::size_t i = 0; i < tail; i += lanes) {
+                for (std::size_t j = 0; j < lanes; ++j) {
+                    auto x = xs[i + j];
+                    sum[j] += x;
+                    // Selects on values, not std::min's references, which would keep a branch in the loop
+                    min[j] = x < min[j] ? x : min[j];
+                    max[j] = x > max[j] ? x : max[j];
+                }
+            }
+            for (std::size_t i = tail; i < xs.size(); ++i) {
+                sum[0] += xs[i];
+                min[0] = std::min(min[0], xs[i]);
+                max[0] = std::max(max[0], xs[i]);
+            }
+            double mean = std::accumulate(sum.begin(), sum.end(), 0.0) / static_cast<double>(xs.size());
+
+            std::array<double, lanes> squares{};
+            for (std::size_t i = 0; i < tail; i += lanes) {
+                for (std::size_t j = 0; j < lanes; ++j) {
+                    squares[j] += (xs[i + j] - mean) * (xs[i + j] - mean);
+                }
+            }
+            for (std::size_t i = tail; i < xs.size(); ++i) {
+                squares[0] += (xs[i] - mean) * (xs[i] - mean);
+            }
+            double sum_of_squares = std::accumulate(squares.begin(), squares.end(), 0.0);
+
+            merge(WelfordAlgorithm(xs.size(), mean, sum_of_squares, std::ranges::min(min), std::ranges::max(max)));
+        }
+
+        /// \brief Merge the values added to another instance, using Chan's parallel formula
+        /// \param other Instance to merge
+        void merge(const WelfordAlgorithm &other) {
+            if (other.count_ == 0) {
+                return;
+            }
+            auto count = count_ + other.count_;
+            double delta = other.mean_ - mean_;
+            double weight = static_cast<double>(other.count_) / static_cast<double>(count);
+            mean_ += delta * weight;
+            sum_of_squares_ += other.sum_of_squares_ + delta * delta * static_cast<double>(count_) * weight;
+            count_ = count;
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+        }
+
+        /// \return The number of values added
+        [[nodiscard]] std::size_t getCount() const { return count_; }
+
+        /// \return The smallest value added (+infinity if there are none)
+        [[nodiscard]] double getMin() const { return min_; }
+
+        /// \return The largest value added (-infinity if there are none)
+        [[nodiscard]] double getMax() const { return max_; }
+
         /// \return The mean
         [[nodiscard]] double getMean() const { return mean_; }
 
@@ -30,10 +117,194 @@ namespace dferone {
         /// \return The standard deviation
         [[nodiscard]] double getStdDev() const { return std::sqrt(getVariance()); }
 
+        WelfordAlgorithm() = default;
+
     private:
+        /// Independent accumulators of addElements()
+        static constexpr std::size_t lanes = 4;
+
+        WelfordAlgorithm(std::size_t count, double mean, double sum_of_squares, double min, double max)
+            : count_(count), mean_(mean), sum_of_squares_(sum_of_squares), min_(min), max_(max) {}
+
+        friend class ConcurrentWelfordAlgorithm;
+
+        std::size_t count_{0};
+        double mean_{0.0};
+        double sum_of_squares_{0.0};
+        double min_{std::numeric_limits<double>::infinity()};
+        double max_{-std::numeric_limits<double>::infinity()};
+    };
+
+    /// \brief Welford's algorithm fed by many threads without locks
+    ///
+    /// Values are added to shards, each one updated by a single thread at a time (e.g. the thread with that id).
+    /// Every shard publishes its statistics through a seqlock, so that getSnapshot() can merge them
+    /// while the writers keep going.
+    class ConcurrentWelfordAlgorithm {
+    public:
+        /// \param num_shards Number of shards, usually the number of writer threads
+        explicit ConcurrentWelfordAlgorithm(std::size_t num_shards) : num_shards_(num_shards), shards_(std::make_unique<Shard[]>(num_shards)) {}
+
+        /// \brief Add a value
+        /// \param shard Shard to update, it must not be updated concurrently by another thread
+        /// \param x     Value to add
+        void addElement(std::size_t shard, double x) {
+            auto &s = shards_[shard];
+            s.local.addElement(x);
+            s.publish();
+        }
+
+        /// \brief Add a batch of values
+        /// \param shard Shard to update, it must not be updated concurrently by another thread
+        /// \param xs    Values to add
+        void addElements(std::size_t shard, std::span<const double> xs) {
+            auto &s = shards_[shard];
+            s.local.addElements(xs);
+            s.publish();
+        }
+
+        /// \return The statistics of all the values added so far
+        [[nodiscard]] WelfordAlgorithm getSnapshot() const {
+            WelfordAlgorithm result;
+            for (std::size_t i = 0; i < num_shards_; ++i) {
+                result.merge(shards_[i].read());
+            }
+            return result;
+        }
+
+        /// \return The number of shards
+        [[nodiscard]] std::size_t getNumShards() const { return num_shards_; }
+
+    private:
+        /// Statistics of a single writer, on its own cache line
+        struct alignas(64) Shard {
+            /// Copy of the statistics only accessed by the writer
+            WelfordAlgorithm local;
+
+            /// Odd while the writer is publishing
+            std::atomic<std::uint64_t> sequence{0};
+
+            std::atomic<std::size_t> count{0};
+            std::atomic<double> mean{0.0};
+            std::atomic<double> sum_of_squares{0.0};
+            std::atomic<double> min{std::numeric_limits<double>::infinity()};
+            std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+
+            void publish() {
+                auto seq = sequence.load(std::memory_order_relaxed);
+                sequence.store(seq + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                count.store(local.count_, std::memory_order_relaxed);
+                mean.store(local.mean_, std::memory_order_relaxed);
+                sum_of_squares.store(local.sum_of_squares_, std::memory_order_relaxed);
+                min.store(local.min_, std::memory_order_relaxed);
+                max.store(local.max_, std::memory_order_relaxed);
+                sequence.store(seq + 2, std::memory_order_release);
+            }
+
+            [[nodiscard]] WelfordAlgorithm read() const {
+                while (true) {
+                    auto before = sequence.load(std::memory_order_acquire);
+                    WelfordAlgorithm wa(count.load(std::memory_order_relaxed), mean.load(std::memory_order_relaxed),
+                                        sum_of_squares.load(std::memory_order_relaxed), min.load(std::memory_order_relaxed),
+                                        max.load(std::memory_order_relaxed));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if ((before & 1) == 0 && before == sequence.load(std::memory_order_relaxed)) {
+                        return wa;
+                    }
+                }
+            }
+        };
+
+        std::size_t num_shards_;
+        std::unique_ptr<Shard[]> shards_;
+    };
+
+    /// \brief Welford's algorithm restricted to the last values added
+    ///
+    /// Values leaving the window are removed by reverting the Welford update; minimum and maximum are
+    /// kept with monotonic queues, so every operation is amortised O(1).
+    class SlidingWelfordAlgorithm {
+    public:
+        /// \param window Number of values considered, at least 1
+        explicit SlidingWelfordAlgorithm(std::size_t window) : window_(window), values_(window) {
+            if (window_ == 0) {
+                throw std::runtime_error("Sliding window of size 0!");
+            }
+        }
+
+        /// \brief Add a value, removing the oldest one if the window is full
+        /// \param x Value to add
+        void addElement(double x) {
+            if (count_ == window_) {
+                removeOldest();
+            }
+
+            auto index = added_++;
+            values_[index % window_] = x;
+            ++count_;
+            double delta = x - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            sum_of_squares_ += delta * (x - mean_);
+
+            while (!min_queue_.empty() && min_queue_.back().second >= x) {
+                min_queue_.pop_back();
+            }
+            min_queue_.emplace_back(index, x);
+            while (!max_queue_.empty() && max_queue_.back().second <= x) {
+                max_queue_.pop_back();
+            }
+            max_queue_.emplace_back(index, x);
+        }
+
+        /// \return The number of values in the window
+        [[nodiscard]] std::size_t getCount() const { return count_; }
+
+        /// \return The smallest value in the window
+        [[nodiscard]] double getMin() const { return min_queue_.empty() ? std::numeric_limits<double>::infinity() : min_queue_.front().second; }
+
+        /// \return The largest value in the window
+        [[nodiscard]] double getMax() const { return max_queue_.empty() ? -std::numeric_limits<double>::infinity() : max_queue_.front().second; }
+
+        /// \return The mean of the window
+        [[nodiscard]] double getMean() const { return mean_; }
+
+        /// \return The variance of the window
+        [[nodiscard]] double getVariance() const { return std::max(sum_of_squares_, 0.0) / static_cast<double>(count_); }
+
+        /// \return The standard deviation of the window
+        [[nodiscard]] double getStdDev() const { return std::sqrt(getVariance()); }
+
+    private:
+        void removeOldest() {
+            auto index = added_ - count_;
+            double x = values_[index % window_];
+            --count_;
+            if (count_ == 0) {
+                mean_ = 0.0;
+                sum_of_squares_ = 0.0;
+            } else {
+                double old_mean = mean_;
+                mean_ -= (x - mean_) / static_cast<double>(count_);
+                sum_of_squares_ -= (x - old_mean) * (x - mean_);
+            }
+
+            if (min_queue_.front().first == index) {
+                min_queue_.pop_front();
+            }
+            if (max_queue_.front().first == index) {
+                max_queue_.pop_front();
+            }
+        }
+
+        std::size_t window_;
+        std::vector<double> values_;
+        std::size_t added_{0};
         std::size_t count_{0};
         double mean_{0.0};
         double sum_of_squares_{0.0};
+        std::deque<std::pair<std::size_t, double>> min_queue_;
+        std::deque<std::pair<std::size_t, double>> max_queue_;
     };
 
-} // namespace dferone
\ No newline at end of file
+} // namespace dferone
@@ -0,0 +1,471 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <dferone/algorithms/EliteVisitor.h>
+#include <dferone/algorithms/GRASP.h>
+#include <dferone/algorithms/PathRelinking.h>
+#include <dferone/algorithms/SolutionConstructor.h>
+#include <dferone/random.h>
+#include <thread>
+
+namespace {
+    using namespace dferone::algorithms;
+
+    struct Instance {};
+
+    struct Solution {
+    public:
+        explicit Solution(const Instance &, double c = std::numeric_limits<double>::max()) : cost_(c) {}
+
+        [[nodiscard]] constexpr double getCost() const { return cost_; }
+
+        void update(double x) { cost_ += x; }
+
+    private:
+        double cost_;
+    };
+
+    class SC : public SolutionConstructor<Instance, Solution> {
+    public:
+        Solution createSolution(const Instance &instance, std::mt19937 &mt) override {
+            std::uniform_real_distribution<double> dis(0, 10);
+            return Solution(instance, dis(mt));
+        }
+
+        [[nodiscard]] std::unique_ptr<SolutionConstructor<Instance, Solution>> clone() const override { return std::make_unique<SC>(); }
+    };
+
+    struct LS : public LocalSearch<Solution> {
+        void search(Solution &s, std::mt19937 &) override { s.update(-std::min(s.getCost(), 1.0)); }
+
+        [[nodiscard]] std::unique_ptr<LocalSearch<Solution>> clone() const override { return std::make_unique<LS>(); }
+    };
+
+    TEST(Grasp, creation) {
+        std::mt19937 mt(0);
+        Instance instance;
+        GRASP<Instance, Solution> g(instance, 0);
+        g.setMaxIterations(10);
+        ASSERT_ANY_THROW(g.solve(1));
+        auto sc = std::make_unique<SC>();
+        auto s = sc->createSolution(instance, mt);
+        ASSERT_GE(s.getCost(), 0.0);
+        ASSERT_LE(s.getCost(), 10.0);
+        g.addSolutionConstructor(std::move(sc));
+        g.addLocalSearch(std::make_unique<LS>());
+        s = g.solve(3);
+        ASSERT_GE(s.getCost(), 0.0);
+        ASSERT_LE(s.getCost(), 10.0);
+        GRASP<Instance, Solution> g2(instance, 0);
+        g2.addSolutionConstructor(std::make_unique<SC>());
+        g2.addLocalSearch(std::make_unique<LS>());
+        g2.setMaxIterations(150);
+        auto s2 = g2.solve(3);
+        ASSERT_LE(s2.getCost(), s.getCost());
+    }
+
+    struct CountingVisitor : public AlgorithmVisitor<Solution> {
+        explicit CountingVisitor(std::atomic<std::size_t> &iterations) : iterations_(iterations) {}
+        void on_algorithm_start() override {}
+        bool on_construction_end(AlgorithmStatus<Solution> &) override { return true; }
+        void on_iteration_end(AlgorithmStatus<Solution> &) override { ++iterations_; }
+        std::atomic<std::size_t> &iterations_;
+    };
+
+    TEST(Grasp, global_iteration_budget) {
+        Instance instance;
+        std::atomic<std::size_t> iterations{0};
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<SC>());
+        g.addLocalSearch(std::make_unique<LS>());
+        g.addVisitor(std::make_unique<CountingVisitor>(iterations));
+        g.setMaxIterations(10);
+        g.solve(4);
+        ASSERT_EQ(iterations, 10);
+    }
+
+    TEST(Grasp, thread_local_incumbents) {
+        Instance instance;
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<SC>());
+        g.addLocalSearch(std::make_unique<LS>());
+        g.setIncumbentPolicy(IncumbentPolicy::ThreadLocal);
+        g.setMaxIterations(50);
+        auto s = g.solve(4);
+        ASSERT_GE(s.getCost(), 0.0);
+        ASSERT_LE(s.getCost(), 9.0);
+        g.setTarget(s.getCost());
+        ASSERT_DOUBLE_EQ(g.solve(2).getCost(), s.getCost());
+    }
+
+    TEST(Grasp, thread_pool) {
+        Instance instance;
+        auto pool = std::make_shared<ThreadPool>(4);
+        ASSERT_EQ(pool->size(), 4);
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<SC>());
+        g.addLocalSearch(std::make_unique<LS>());
+        g.bindThreadPool(pool);
+        g.setMaxIterations(5);
+        double previous = std::numeric_limits<double>::max();
+        for (int i = 0; i < 20; ++i) {
+            auto s = g.solve(1 + i % 4);
+            ASSERT_LE(s.getCost(), previous);
+            previous = s.getCost();
+        }
+        ASSERT_ANY_THROW(g.solve(5));
+    }
+
+    struct SplitLS : public LocalSearch<Solution> {
+        void search(Solution &s, std::mt19937 &) override {
+            std::atomic<int> steps{0};
+            ThreadPool::TaskGroup group;
+            for (int i = 0; i < 8; ++i) {
+                group.run([&steps]() { ++steps; });
+            }
+            group.wait();
+            s.update(-std::min(s.getCost(), steps / 8.0));
+        }
+        [[nodiscard]] std::unique_ptr<LocalSearch<Solution>> clone() const override { return std::make_unique<SplitLS>(); }
+    };
+
+    TEST(Grasp, split_local_search) {
+        Instance instance;
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<SC>());
+        g.addLocalSearch(std::make_unique<SplitLS>());
+        g.bindThreadPool(std::make_shared<ThreadPool>(4));
+        g.setMaxIterations(20);
+        auto s = g.solve(4);
+        ASSERT_GE(s.getCost(), 0.0);
+        ASSERT_LE(s.getCost(), 9.0);
+    }
+
+    std::atomic<std::size_t> ls_calls{0};
+
+    struct CountingLS : public LS {
+        void search(Solution &s, std::mt19937 &mt) override {
+            ++ls_calls;
+            LS::search(s, mt);
+        }
+        [[nodiscard]] std::unique_ptr<LocalSearch<Solution>> clone() const override { return std::make_unique<CountingLS>(); }
+    };
+
+    TEST(Grasp, filtering) {
+        Instance instance;
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<SC>());
+        g.addLocalSearch(std::make_unique<CountingLS>());
+        g.setFiltering(20, 0.0);
+        g.setMaxIterations(200);
+        ls_calls = 0;
+        auto s = g.solve(4);
+        ASSERT_GE(ls_calls, 20);
+        ASSERT_LT(ls_calls, 200);
+        ASSERT_LE(s.getCost(), 9.0);
+    }
+
+    TEST(Grasp, elite_visitor) {
+        Instance instance;
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<SC>());
+        auto similar = [](const Solution &a, const Solution &b) { return std::abs(a.getCost() - b.getCost()) < 0.1; };
+        auto pool = std::make_shared<ElitePool<Solution>>(10, 4, similar);
+        g.addVisitor(std::make_unique<EliteVisitor<Solution>>(pool));
+        g.setMaxIterations(200);
+        auto s = g.solve(4);
+
+        auto elite = pool->snapshot();
+        ASSERT_EQ(elite.size(), 10);
+        ASSERT_DOUBLE_EQ(elite.front().getCost(), s.getCost());
+        for (std::size_t i = 1; i < elite.size(); ++i) {
+            ASSERT_GE(elite[i].getCost() - elite[i - 1].getCost(), 0.1);
+        }
+    }
+
+    template<class Rng>
+    struct EngineSC : public SolutionConstructor<Instance, Solution, Rng> {
+        Solution createSolution(const Instance &instance, Rng &rng) override {
+            return Solution(instance, static_cast<double>(dferone::random::bounded_rand(rng, 1000)) / 100.0);
+        }
+        [[nodiscard]] std::unique_ptr<SolutionConstructor<Instance, Solution, Rng>> clone() const override { return std::make_unique<EngineSC>(); }
+    };
+
+    using XoshiroSC = EngineSC<dferone::random::Xoshiro256StarStar>;
+
+    template<class Rng>
+    void solve_with_engine() {
+        Instance instance;
+        GRASP<Instance, Solution, Rng> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<EngineSC<Rng>>());
+        g.setMaxIterations(100);
+        auto s = g.solve(2);
+        ASSERT_GE(s.getCost(), 0.0);
+        ASSERT_LE(s.getCost(), 1.0);
+    }
+
+    TEST(Grasp, custom_engine) {
+        solve_with_engine<dferone::random::Xoshiro256StarStar>();
+        solve_with_engine<dferone::random::Pcg64>();
+    }
+
+    TEST(Grasp, reproducible) {
+        Instance instance;
+        for (auto policy : {IncumbentPolicy::Shared, IncumbentPolicy::ThreadLocal}) {
+            std::vector<double> costs;
+            for (std::uint32_t threads : {1u, 2u, 4u}) {
+                GRASP<Instance, Solution> g(instance, 42);
+                g.addSolutionConstructor(std::make_unique<SC>());
+                g.setIncumbentPolicy(policy);
+                g.setReproducible(true);
+                g.setMaxIterations(50);
+                costs.push_back(g.solve(threads).getCost());
+                // The second solve draws different streams, but still the same ones for any number of threads
+                g.setMaxIterations(100);
+                costs.push_back(g.solve(threads).getCost());
+            }
+            for (std::size_t i = 2; i < costs.size(); ++i) {
+                ASSERT_EQ(costs[i], costs[i % 2]);
+            }
+            ASSERT_LE(costs[1], costs[0]);
+        }
+
+        // A 64-bit engine is seeded with the whole key of the iteration
+        std::vector<double> costs;
+        for (std::uint32_t threads : {1u, 3u}) {
+            GRASP<Instance, Solution, dferone::random::Xoshiro256StarStar> g(instance, 42);
+            g.addSolutionConstructor(std::make_unique<XoshiroSC>());
+            g.setReproducible(true);
+            g.setMaxIterations(100);
+            costs.push_back(g.solve(threads).getCost());
+        }
+        ASSERT_EQ(costs[0], costs[1]);
+    }
+
+    /// Components as value types, with no virtual interface
+    struct ValueSC {
+        Solution createSolution(const Instance &instance, std::mt19937 &mt) {
+            ++calls;
+            return Solution(instance, std::uniform_real_distribution<double>(0, 10)(mt));
+        }
+        std::size_t calls{0};
+    };
+
+    struct ValueLS {
+        void search(Solution &s, std::mt19937 &) { s.update(-std::min(s.getCost(), step)); }
+        double step;
+    };
+
+    struct ValueVisitor {
+        void on_algorithm_start() {}
+        bool on_construction_end(AlgorithmStatus<Solution> &) { return true; }
+        void on_iteration_end(AlgorithmStatus<Solution> &) { ++iterations; }
+        std::size_t iterations{0};
+    };
+
+    struct VirtualValueSC : public SolutionConstructor<Instance, Solution> {
+        Solution createSolution(const Instance &instance, std::mt19937 &mt) override { return sc.createSolution(instance, mt); }
+        [[nodiscard]] std::unique_ptr<SolutionConstructor<Instance, Solution>> clone() const override { return std::make_unique<VirtualValueSC>(); }
+        ValueSC sc;
+    };
+
+    TEST(Grasp, static_policies) {
+        Instance instance;
+        BasicGRASP<Instance, Solution, ValueSC, ValueLS, ValueVisitor> g(instance, 7, ValueSC{}, ValueLS{1.0});
+        g.setMaxIterations(100);
+        auto s = g.solve(4);
+        ASSERT_GE(s.getCost(), 0.0);
+        ASSERT_LE(s.getCost(), 9.0);
+
+        // Without local search the result is the same as the virtual GRASP with the same constructor
+        BasicGRASP<Instance, Solution, ValueSC> no_ls(instance, 7);
+        no_ls.setReproducible(true);
+        no_ls.setMaxIterations(100);
+        GRASP<Instance, Solution> g2(instance, 7);
+        g2.addSolutionConstructor(std::make_unique<VirtualValueSC>());
+        g2.setReproducible(true);
+        g2.setMaxIterations(100);
+        ASSERT_EQ(no_ls.solve(3).getCost(), g2.solve(2).getCost());
+    }
+
+    /// Solution owning a buffer, to check that GRASP recycles it
+    struct VectorSolution {
+        explicit VectorSolution(const Instance &) {}
+        [[nodiscard]] double getCost() const { return cost; }
+        std::vector<double> values;
+        double cost{std::numeric_limits<double>::max()};
+    };
+
+    struct InPlaceSC {
+        void buildSolutionInto(const Instance &, VectorSolution &s, std::mt19937 &mt) {
+            if (s.values.capacity() == 0) {
+                ++*allocations;
+            }
+            s.values.assign(64, 0.0);
+            std::uniform_real_distribution<double> dis(0, 10);
+            std::ranges::generate(s.values, [&] { return dis(mt); });
+            s.cost = std::ranges::min(s.values);
+        }
+        // Shared by the copies of the threads
+        std::shared_ptr<std::atomic<std::size_t>> allocations = std::make_shared<std::atomic<std::size_t>>(0);
+    };
+
+    TEST(Grasp, solution_recycling) {
+        Instance instance;
+        for (auto policy : {IncumbentPolicy::Shared, IncumbentPolicy::ThreadLocal}) {
+            InPlaceSC sc;
+            auto allocations = sc.allocations;
+            BasicGRASP<Instance, VectorSolution, InPlaceSC> g(instance, 0, sc);
+            g.setIncumbentPolicy(policy);
+            g.setMaxIterations(500);
+            auto s = g.solve(4);
+            ASSERT_EQ(s.values.size(), 64);
+            ASSERT_EQ(s.cost, std::ranges::min(s.values));
+            // Only the first solution of every thread, and the empty incumbents swapped out at the first improvements, allocate
+            ASSERT_LE(*allocations, 2 * 4 + 1);
+        }
+    }
+
+    /// The smaller the parameter, the better the solutions
+    struct ParametricSC : public SolutionConstructor<Instance, Solution> {
+        explicit ParametricSC(std::shared_ptr<std::array<std::atomic<std::size_t>, 3>> uses) : uses_(std::move(uses)) {}
+        void setParameter(double alpha) override { alpha_ = alpha; }
+        Solution createSolution(const Instance &instance, std::mt19937 &mt) override {
+            ++(*uses_)[static_cast<std::size_t>(alpha_ * 2.0)];
+            return Solution(instance, 1.0 + 10.0 * alpha_ + std::uniform_real_distribution<double>(0, 1)(mt));
+        }
+        [[nodiscard]] std::unique_ptr<SolutionConstructor<Instance, Solution>> clone() const override { return std::make_unique<ParametricSC>(uses_); }
+        std::shared_ptr<std::array<std::atomic<std::size_t>, 3>> uses_;
+        double alpha_{0.0};
+    };
+
+    TEST(Grasp, reactive) {
+        Instance instance;
+        auto uses = std::make_shared<std::array<std::atomic<std::size_t>, 3>>();
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<ParametricSC>(uses));
+        ASSERT_TRUE(g.getParameterProbabilities().empty());
+        g.setReactive({0.0, 0.5, 1.0}, 20, 2.0);
+        g.setMaxIterations(2000);
+        auto s = g.solve(4);
+        ASSERT_LE(s.getCost(), 1.1);
+
+        auto probabilities = g.getParameterProbabilities();
+        ASSERT_EQ(probabilities.size(), 3);
+        ASSERT_GT(probabilities[0], probabilities[1]);
+        ASSERT_GT(probabilities[1], probabilities[2]);
+        ASSERT_GT((*uses)[0], (*uses)[1] + (*uses)[2]);
+        ASSERT_EQ((*uses)[0] + (*uses)[1] + (*uses)[2], 2000);
+    }
+
+    /// Bit string whose cost is one plus the number of bits different from the hidden optimum, all ones
+    struct BitSolution {
+        explicit BitSolution(const Instance &) {}
+        [[nodiscard]] double getCost() const {
+            return bits.empty() ? std::numeric_limits<double>::max() : 1.0 + static_cast<double>(std::ranges::count(bits, false));
+        }
+        std::vector<bool> bits;
+    };
+
+    struct RandomBits {
+        BitSolution createSolution(const Instance &instance, std::mt19937 &mt) {
+            BitSolution s(instance);
+            s.bits.resize(24);
+            for (auto &&bit : s.bits) {
+                bit = std::bernoulli_distribution(0.3)(mt);
+            }
+            return s;
+        }
+    };
+
+    /// Flips the bits different from the guiding solution, correct bits first
+    struct FlipMoves {
+        std::size_t distance(const BitSolution &s, const BitSolution &guide) const {
+            std::size_t ret = 0;
+            for (std::size_t i = 0; i < s.bits.size(); ++i) {
+                ret += s.bits[i] != guide.bits[i];
+            }
+            return ret;
+        }
+        void step(BitSolution &s, const BitSolution &guide, std::mt19937 &) const {
+            std::size_t flip = s.bits.size();
+            for (std::size_t i = 0; i < s.bits.size(); ++i) {
+                if (s.bits[i] != guide.bits[i] && (flip == s.bits.size() || guide.bits[i])) {
+                    flip = i;
+                }
+            }
+            s.bits[flip] = guide.bits[flip];
+        }
+    };
+
+    TEST(Grasp, path_relinking) {
+        Instance instance;
+        BasicGRASP<Instance, BitSolution, RandomBits> plain(instance, 3);
+        plain.setMaxIterations(300);
+        auto plain_cost = plain.solve(2).getCost();
+
+        auto different = [](const BitSolution &a, const BitSolution &b) { return FlipMoves{}.distance(a, b) < 2; };
+        for (auto strategy : {RelinkingStrategy::Forward, RelinkingStrategy::Backward, RelinkingStrategy::Mixed}) {
+            auto pool = std::make_shared<ElitePool<BitSolution>>(10, 2, different);
+            using PR = PathRelinking<BitSolution, FlipMoves>;
+            BasicGRASP<Instance, BitSolution, RandomBits, PR> g(instance, 3, RandomBits{}, PR(pool, FlipMoves{}, NoLocalSearch{}, strategy));
+            g.setMaxIterations(300);
+            auto s = g.solve(2);
+            ASSERT_LT(s.getCost(), plain_cost);
+            auto elite = pool->snapshot();
+            ASSERT_FALSE(elite.empty());
+            ASSERT_EQ(elite.front().getCost(), s.getCost());
+        }
+
+        // The same stage behind the virtual interface
+        struct VirtualRandomBits : public SolutionConstructor<Instance, BitSolution> {
+            BitSolution createSolution(const Instance &instance, std::mt19937 &mt) override { return RandomBits{}.createSolution(instance, mt); }
+            [[nodiscard]] std::unique_ptr<SolutionConstructor<Instance, BitSolution>> clone() const override { return std::make_unique<VirtualRandomBits>(); }
+        };
+        using VirtualPR = PathRelinking<BitSolution, FlipMoves, VirtualLocalSearch<BitSolution>>;
+        auto pool = std::make_shared<ElitePool<BitSolution>>(10, 2, different);
+        GRASP<Instance, BitSolution> g(instance, 3);
+        g.addSolutionConstructor(std::make_unique<VirtualRandomBits>());
+        g.addLocalSearch(std::make_unique<PolicyLocalSearch<VirtualPR, BitSolution>>(VirtualPR(pool)));
+        g.setMaxIterations(300);
+        ASSERT_LT(g.solve(2).getCost(), plain_cost);
+    }
+
+    TEST(Grasp, solve_async) {
+        Instance instance;
+        GRASP<Instance, Solution> g(instance, 0);
+        g.addSolutionConstructor(std::make_unique<SC>());
+        g.addLocalSearch(std::make_unique<LS>());
+
+        // No stop condition but the cancellation
+        auto handle = g.solve_async(2);
+        while (handle.iterations() < 50) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_FALSE(handle.ready());
+        ASSERT_LE(handle.best_cost(), 9.0);
+        ASSERT_TRUE(handle.request_stop());
+        ASSERT_TRUE(handle.get_stop_token().stop_requested());
+        auto s = handle.get();
+        ASSERT_EQ(s.getCost(), g.getBestCost());
+        auto iterations = g.getIterations();
+        ASSERT_GE(iterations, 50);
+
+        // A solve cancelled before it starts keeps the previous best solution
+        std::stop_source stopped;
+        stopped.request_stop();
+        ASSERT_EQ(g.solve(2, stopped.get_token()).getCost(), s.getCost());
+        ASSERT_EQ(g.getIterations(), 0);
+
+        // Errors reach the future, and destroying a handle cancels its solve
+        GRASP<Instance, Solution> empty(instance, 0);
+        ASSERT_THROW(empty.solve_async(1).get(), std::runtime_error);
+        {
+            auto cancelled = g.solve_async(2);
+        }
+        g.setMaxIterations(10);
+        ASSERT_LE(g.solve_async(1).get().getCost(), s.getCost());
+        ASSERT_EQ(g.getIterations(), 10);
+    }
+} // namespace
@@ -1,21 +1,30 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <dferone/algorithms/ThreadPool.h>
 #include <dferone/console.h>
 #include <dferone/containers/BestSet.h>
+#include <dferone/containers/ConcurrentBestSet.h>
+#include <dferone/containers/EytzingerVector.h>
+#include <dferone/containers/FiniteBitSet.h>
 #include <dferone/containers/FiniteSet.h>
+#include <dferone/containers/HeapBestSet.h>
 #include <dferone/containers/Matrix.h>
+#include <dferone/containers/MatrixFile.h>
 #include <dferone/containers/SoterdVector.h>
 #include <dferone/containers/SymmetricMatrix.h>
 #include <dferone/containers/containers.h>
 #include <dferone/random.h>
 #include <dferone/utilities.h>
 #include <dferone/welford.h>
+#include <filesystem>
 #include <iterator>
 
 namespace {
     using namespace dferone::containers;
     using namespace dferone::random;
     using namespace dferone::console;
+    using dferone::algorithms::ThreadPool;
 
     TEST(Containers, best_set) {
         BestSet<int> bs(5);
@@ -38,6 +47,82 @@ namespace {
         ASSERT_TRUE(contains(bs, 1));
     }
 
+    TEST(Containers, heap_best_set) {
+        HeapBestSet<int> hs(5);
+        ASSERT_TRUE(hs.empty());
+        for (int el : {10, 15, 1, 2, 3}) {
+            ASSERT_TRUE(hs.add(el));
+        }
+        ASSERT_TRUE(hs.full());
+        ASSERT_EQ(hs.top(), 15);
+        ASSERT_EQ(hs.worst(), 1);
+        ASSERT_FALSE(hs.accepts(1));
+        ASSERT_FALSE(hs.add(1));
+        ASSERT_TRUE(hs.add(20));
+        ASSERT_EQ(hs.top(), 20);
+        ASSERT_EQ(hs.worst(), 2);
+        ASSERT_EQ(hs.pop(), 20);
+        ASSERT_EQ(hs.size(), 4);
+        ASSERT_EQ(hs.top(), 15);
+        ASSERT_TRUE(contains(hs, 3));
+
+        HeapBestSet<int> other(3);
+        for (int el : {0, 7, 30}) {
+            other.add(el);
+        }
+        hs.merge(other);
+        ASSERT_EQ(hs.sorted(), (std::vector<int>{30, 15, 10, 7, 3}));
+
+        // Stesso contenuto di BestSet su una sequenza lunga
+        std::mt19937_64 rng(0);
+        std::uniform_int_distribution<int> dis(0, 100000);
+        BestSet<int, std::less<>> bs(50);
+        HeapBestSet<int, std::less<>> heap(50);
+        for (int i = 0; i < 5000; ++i) {
+            auto el = dis(rng);
+            ASSERT_EQ(bs.add(el), heap.add(el));
+            ASSERT_EQ(bs.top(), heap.top());
+            if (i % 100 == 0) {
+                ASSERT_EQ(bs.pop(), heap.pop());
+            }
+        }
+        ASSERT_TRUE(std::equal(bs.begin(), bs.end(), heap.sorted().begin()));
+    }
+
+    TEST(Containers, concurrent_best_set) {
+        ConcurrentBestSet<int> cs(100, 4);
+        ASSERT_FALSE(cs.threshold());
+        ThreadPool pool(4);
+        pool.run(4, [&cs](std::uint32_t id) {
+            for (int i = 0; i < 10000; ++i) {
+                cs.add(id, 4 * i + static_cast<int>(id));
+            }
+        });
+        auto best = cs.snapshot();
+        ASSERT_EQ(best.size(), 100);
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_EQ(best[i], 39999 - i);
+        }
+        ASSERT_TRUE(cs.threshold());
+        ASSERT_FALSE(cs.accepts(0));
+        ASSERT_FALSE(cs.add(0));
+
+        std::mt19937_64 rng(0);
+        auto sampled = cs.sample(rng);
+        ASSERT_TRUE(sampled);
+        ASSERT_GE(*sampled, 39600);
+
+        // Elementi con la stessa decina sono troppo simili
+        ConcurrentBestSet<int> diverse(5, 2, [](int a, int b) { return a / 10 == b / 10; });
+        for (int el : {1, 5, 12, 19, 31, 45, 58, 57, 3}) {
+            diverse.add(el % 2, el);
+        }
+        ASSERT_EQ(diverse.snapshot(), (std::vector<int>{58, 45, 31, 19, 5}));
+        diverse.clear();
+        ASSERT_TRUE(diverse.snapshot().empty());
+        ASSERT_FALSE(diverse.sample(rng));
+    }
+
     TEST(Containers, sorted_set) {
         SortedVector<int> bs;
         bs.add(10);
@@ -56,6 +141,61 @@ namespace {
         ASSERT_TRUE(contains(bs, 15));
     }
 
+    TEST(Containers, sorted_vector_bulk) {
+        std::vector<int> unsorted{5, 3, 9, 1, 3, 7};
+        SortedVector<int> sv(unsorted);
+        ASSERT_TRUE(std::ranges::is_sorted(sv));
+        sv.reserve(100);
+        ASSERT_GE(sv.capacity(), 100);
+        sv.add_bulk(std::vector<int>{8, 0, 3, 10});
+        ASSERT_EQ(std::vector<int>(sv.begin(), sv.end()), (std::vector<int>{0, 1, 3, 3, 3, 5, 7, 8, 9, 10}));
+
+        ASSERT_EQ(sv.lower_bound(3) - sv.begin(), 2);
+        ASSERT_EQ(sv.upper_bound(3) - sv.begin(), 5);
+        ASSERT_EQ(sv.lower_bound(-1), sv.begin());
+        ASSERT_EQ(sv.lower_bound(11), sv.end());
+        ASSERT_EQ(sv.count(3), 3);
+        ASSERT_TRUE(sv.contains(10));
+        ASSERT_FALSE(sv.contains(4));
+        ASSERT_EQ(sv.find(4), sv.end());
+        ASSERT_EQ(*sv.find(7), 7);
+        for (int i = -1; i <= 11; ++i) {
+            ASSERT_EQ(sv.lower_bound(i), std::lower_bound(sv.begin(), sv.end(), i));
+        }
+
+        ASSERT_EQ(sv.erase_if([](int x) { return x % 3 == 0; }), 5);
+        ASSERT_EQ(std::vector<int>(sv.begin(), sv.end()), (std::vector<int>{1, 5, 7, 8, 10}));
+        sv.erase(sv.begin(), sv.begin() + 2);
+        ASSERT_EQ(sv.front(), 7);
+
+        SortedVector<int, std::greater<>> descending(std::vector<int>{1, 2, 3});
+        descending.insert_range(std::vector<int>{0, 4});
+        ASSERT_EQ(descending.front(), 4);
+        ASSERT_EQ(descending.lower_bound(2) - descending.begin(), 2);
+    }
+
+    TEST(Containers, eytzinger_vector) {
+        for (int n : {0, 1, 2, 7, 8, 100, 1000}) {
+            std::vector<int> values;
+            for (int i = 0; i < n; ++i) {
+                values.push_back(2 * i);
+                values.push_back(2 * i);
+            }
+            SortedVector<int> sv(values);
+            EytzingerVector<int> ev(sv);
+            ASSERT_EQ(ev.size(), sv.size());
+            for (int x = -1; x <= 2 * n + 1; ++x) {
+                ASSERT_EQ(ev.lower_bound(x), static_cast<std::size_t>(sv.lower_bound(x) - sv.begin()));
+                ASSERT_EQ(ev.contains(x), sv.contains(x));
+            }
+        }
+
+        EytzingerVector<int, std::greater<>> descending(std::vector<int>{9, 5, 1});
+        ASSERT_EQ(descending.lower_bound(5), 1);
+        ASSERT_EQ(*descending.find(1), 1);
+        ASSERT_EQ(descending.find(2), nullptr);
+    }
+
     TEST(Containers, finite_set) {
         FiniteSet<uint> fs(5);
         ASSERT_EQ(fs.size(), 0);
@@ -82,6 +222,76 @@ namespace {
         join_and_print(fs.complement(), std::cout);
     }
 
+    TEST(Containers, finite_set_copy) {
+        FiniteSet<uint16_t> big(65535, {7, 1000, 65534});
+        FiniteSet<uint16_t> copy(65535, {1, 2, 3, 4, 5});
+
+        // Copia parziale: solo la parte attiva
+        copy = big;
+        ASSERT_EQ(copy.size(), 3);
+        ASSERT_TRUE(std::equal(copy.begin(), copy.end(), big.begin()));
+        for (uint16_t i = 0; i < 10; ++i) {
+            ASSERT_EQ(copy.contains(i), i == 7);
+        }
+        std::vector<uint16_t> all(copy.complement().begin(), copy.complement().end());
+        all.insert(all.end(), copy.begin(), copy.end());
+        std::ranges::sort(all);
+        ASSERT_EQ(all.size(), 65535);
+        ASSERT_EQ(std::ranges::adjacent_find(all), all.end());
+
+        copy.remove(1000);
+        copy.add(5);
+        ASSERT_TRUE(big.contains(1000));
+        ASSERT_FALSE(big.contains(5));
+
+        // Copia completa, con capacità diversa
+        FiniteSet<uint16_t> small(10, 8);
+        small = big;
+        ASSERT_EQ(small.capacity(), 65535);
+        ASSERT_TRUE(std::equal(small.begin(), small.end(), big.begin()));
+
+        small.clear();
+        ASSERT_TRUE(small.empty());
+        ASSERT_FALSE(small.contains(7));
+    }
+
+    TEST(Containers, finite_bit_set) {
+        static_assert(std::ranges::forward_range<FiniteBitSet<uint>>);
+        FiniteBitSet<uint> a(1000, {1, 3, 64, 500, 999});
+        FiniteBitSet<uint> b(1000, {3, 64, 65, 998});
+        a.add(2000);
+        ASSERT_EQ(a.size(), 5);
+        ASSERT_TRUE(a.contains(999));
+        ASSERT_FALSE(a.contains(998));
+        ASSERT_TRUE(contains(a, 500));
+        ASSERT_EQ(a.intersection_size(b), 2);
+
+        auto u = a | b;
+        ASSERT_EQ(u.size(), 7);
+        ASSERT_EQ(std::vector<uint>(u.begin(), u.end()), (std::vector<uint>{1, 3, 64, 65, 500, 998, 999}));
+        auto i = a & b;
+        ASSERT_EQ(std::vector<uint>(i.begin(), i.end()), (std::vector<uint>{3, 64}));
+        auto d = a - b;
+        ASSERT_EQ(std::vector<uint>(d.begin(), d.end()), (std::vector<uint>{1, 500, 999}));
+        d.remove(500);
+        d.remove(500);
+        ASSERT_EQ(d.size(), 2);
+        std::ostringstream ss;
+        ss << d;
+        ASSERT_EQ(ss.str(), "{1, 999}");
+
+        auto fs = d.to_finite_set();
+        ASSERT_EQ(fs.size(), 2);
+        ASSERT_TRUE(fs.contains(999));
+        ASSERT_EQ(FiniteBitSet<uint>(fs), d);
+        auto compact = d.to_finite_set<std::uint16_t>();
+        ASSERT_TRUE(compact.contains(1));
+        ASSERT_EQ(FiniteBitSet<uint>(compact), d);
+        d.reset();
+        ASSERT_TRUE(d.empty());
+        ASSERT_EQ(d.begin(), d.end());
+    }
+
     TEST(Containers, j_and_p) {
         std::vector<int> v{1, 2, 3};
         std::ostringstream ss;
@@ -117,6 +327,161 @@ namespace {
             ASSERT_GE(*q, 0);
             ASSERT_LE(*q, 9);
         }
+
+        // The same seed selects the same elements as std::uniform_int_distribution
+        std::mt19937_64 a(3);
+        std::mt19937_64 b(3);
+        std::uniform_int_distribution<std::size_t> dis(0, v.size() - 1);
+        for (uint i = 0; i < 100; ++i) {
+            ASSERT_EQ(*random_select(v, a), v[dis(b)]);
+        }
+    }
+
+    TEST(random, engines) {
+        static_assert(URBG<SplitMix64> && URBG<Xoshiro256StarStar> && URBG<Pcg64>);
+        SplitMix64 sm(0);
+        ASSERT_EQ(sm(), 0xe220a8397b1dcdafULL);
+
+        Xoshiro256StarStar x(42);
+        Xoshiro256StarStar y(42);
+        ASSERT_EQ(x(), y());
+        y.jump();
+        ASSERT_NE(x, y);
+        std::seed_seq seq{1, 2, 3};
+        Xoshiro256StarStar z(seq);
+        ASSERT_EQ(z(), Xoshiro256StarStar(seq)());
+
+        Pcg64 p(7, 0);
+        Pcg64 q(7, 1);
+        ASSERT_NE(p(), q());
+        ASSERT_EQ(Pcg64(7, 1)(), Pcg64(7, 1)());
+        ASSERT_EQ(Pcg64(seq)(), Pcg64(seq)());
+        static_assert(std::constructible_from<Pcg64, std::seed_seq &>);
+
+        std::array<std::size_t, 7> counts{};
+        for (int i = 0; i < 70000; ++i) {
+            ++counts[bounded_rand(x, 7)];
+        }
+        for (auto count : counts) {
+            ASSERT_NEAR(count, 10000, 500);
+        }
+        std::mt19937 mt(0);
+        for (int i = 0; i < 1000; ++i) {
+            auto v = uniform_int(mt, -5, 5);
+            ASSERT_GE(v, -5);
+            ASSERT_LE(v, 5);
+            ASSERT_LT(bounded_rand(p, 3), 3);
+        }
+        ASSERT_EQ(uniform_int(x, 4, 4), 4);
+
+        // Lane 0 of the batch follows the engine with the same seed, lane 1 its jumped copy
+        Xoshiro256StarStarBatch<4> batch(42);
+        std::vector<std::uint64_t> words(10);
+        batch.fill(words);
+        Xoshiro256StarStar lane0(42);
+        Xoshiro256StarStar lane1(42);
+        lane1.jump();
+        ASSERT_EQ(words[0], lane0());
+        ASSERT_EQ(words[1], lane1());
+        ASSERT_EQ(words[4], lane0());
+        ASSERT_EQ(words[5], lane1());
+        std::vector<double> unit(13);
+        batch.fill(unit);
+        ASSERT_TRUE(std::ranges::all_of(unit, [](double u) { return u >= 0.0 && u < 1.0; }));
+    }
+
+    TEST(random, weighted) {
+        std::vector<double> weights{1, 2, 3, 0, 4};
+        AliasTable alias(weights);
+        FenwickSampler fenwick(weights);
+        ASSERT_DOUBLE_EQ(fenwick.total(), 10.0);
+
+        Xoshiro256StarStar rng(0);
+        std::array<int, 5> alias_counts{};
+        std::array<int, 5> fenwick_counts{};
+        for (int i = 0; i < 100000; ++i) {
+            ++alias_counts[alias(rng)];
+            ++fenwick_counts[fenwick(rng)];
+        }
+        for (std::size_t i = 0; i < weights.size(); ++i) {
+            ASSERT_NEAR(alias_counts[i], weights[i] * 10000, 600);
+            ASSERT_NEAR(fenwick_counts[i], weights[i] * 10000, 600);
+        }
+
+        fenwick.remove(4);
+        fenwick.set(3, 4.0);
+        fenwick.set(0, 0.0);
+        ASSERT_DOUBLE_EQ(fenwick.total(), 9.0);
+        std::array<int, 5> counts{};
+        for (int i = 0; i < 90000; ++i) {
+            ++counts[fenwick(rng)];
+        }
+        ASSERT_EQ(counts[0], 0);
+        ASSERT_EQ(counts[4], 0);
+        ASSERT_NEAR(counts[3], 40000, 800);
+
+        FenwickSampler single(1);
+        single.set(0, 0.5);
+        ASSERT_EQ(single(rng), 0);
+
+        // Removing every weight leaves a rounding residue in the tree, which must not be drawn from
+        FenwickSampler drift(4);
+        drift.set(0, 0.1);
+        drift.set(1, 0.2);
+        drift.set(2, 0.3);
+        for (std::size_t i = 0; i < 3; ++i) {
+            drift.remove(i);
+        }
+        ASSERT_EQ(drift.positive(), 0);
+        ASSERT_THROW(drift(rng), std::runtime_error);
+        // A weight far below the residue is still drawn
+        drift.set(3, 1e-30);
+        ASSERT_EQ(drift(rng), 3);
+    }
+
+    TEST(random, sampling) {
+        Xoshiro256StarStar rng(1);
+        std::vector<int> v(100);
+        std::iota(v.begin(), v.end(), 0);
+        for (std::size_t k : {0, 1, 10, 60, 100}) {
+            auto sample = sample_k(v, k, rng);
+            ASSERT_EQ(sample.size(), k);
+            std::ranges::sort(sample);
+            ASSERT_EQ(std::ranges::adjacent_find(sample), sample.end());
+        }
+
+        // Ogni elemento deve comparire con frequenza k / n
+        std::array<int, 10> counts{};
+        std::vector<int> small(10);
+        std::iota(small.begin(), small.end(), 0);
+        for (int i = 0; i < 20000; ++i) {
+            for (auto el : sample_k(small, 2, rng)) {
+                ++counts[el];
+            }
+            for (auto el : reservoir_sample(std::views::iota(0, 10), 2, rng)) {
+                ++counts[el];
+            }
+        }
+        for (auto count : counts) {
+            ASSERT_NEAR(count, 8000, 400);
+        }
+        ASSERT_EQ(reservoir_sample(std::views::iota(0, 3), 5, rng).size(), 3);
+        ASSERT_EQ(reservoir_sample(std::views::iota(0, 100000), 5, rng).size(), 5);
+
+        FiniteSet<uint> fs(20, 10);
+        auto sample = fs.sample(4, rng);
+        ASSERT_EQ(sample.size(), 4);
+        ASSERT_TRUE(std::ranges::all_of(sample, [&fs](uint el) { return fs.contains(el); }));
+        auto outside = fs.sample_complement(10, rng);
+        ASSERT_TRUE(std::ranges::none_of(outside, [&fs](uint el) { return fs.contains(el); }));
+        ASSERT_EQ(fs.size(), 10);
+        auto removed = fs.random_remove(rng);
+        ASSERT_FALSE(fs.contains(removed));
+        ASSERT_EQ(fs.size(), 9);
+        ASSERT_TRUE(fs.contains(fs.random_element(rng)));
+        for (uint i = 0; i < 20; ++i) {
+            ASSERT_EQ(fs.contains(i), std::find(fs.begin(), fs.end(), i) != fs.end());
+        }
     }
 
     TEST(welford, mean) {
@@ -141,6 +506,65 @@ namespace {
         ASSERT_DOUBLE_EQ(mean, wa.getMean());
         ASSERT_DOUBLE_EQ(variance, wa.getVariance());
         ASSERT_DOUBLE_EQ(std_dev, wa.getStdDev());
+
+        dferone::WelfordAlgorithm first;
+        dferone::WelfordAlgorithm second;
+        for (auto el : x) {
+            (el < 300 ? first : second).addElement(el);
+        }
+        first.merge(second);
+        ASSERT_EQ(first.getCount(), x.size());
+        ASSERT_DOUBLE_EQ(mean, first.getMean());
+        ASSERT_DOUBLE_EQ(variance, first.getVariance());
+        ASSERT_DOUBLE_EQ(0, first.getMin());
+        ASSERT_DOUBLE_EQ(999, first.getMax());
+    }
+
+    TEST(welford, batch_and_concurrent) {
+        std::vector<double> x(1000);
+        std::iota(x.begin(), x.end(), 0);
+        dferone::WelfordAlgorithm single;
+        for (auto el : x) {
+            single.addElement(el);
+        }
+
+        dferone::WelfordAlgorithm batch;
+        batch.addElements(std::span(x).first(10));
+        batch.addElements(std::span(x).subspan(10));
+        ASSERT_EQ(batch.getCount(), single.getCount());
+        ASSERT_DOUBLE_EQ(batch.getMean(), single.getMean());
+        ASSERT_DOUBLE_EQ(batch.getVariance(), single.getVariance());
+
+        dferone::ConcurrentWelfordAlgorithm concurrent(4);
+        ThreadPool pool(4);
+        pool.run(4, [&](std::uint32_t id) {
+            for (auto i = id; i < x.size(); i += 4) {
+                concurrent.addElement(id, x[i]);
+            }
+        });
+        auto snapshot = concurrent.getSnapshot();
+        ASSERT_EQ(snapshot.getCount(), single.getCount());
+        ASSERT_DOUBLE_EQ(snapshot.getMean(), single.getMean());
+        ASSERT_DOUBLE_EQ(snapshot.getVariance(), single.getVariance());
+        ASSERT_DOUBLE_EQ(snapshot.getMax(), 999);
+    }
+
+    TEST(welford, sliding) {
+        dferone::SlidingWelfordAlgorithm wa(10);
+        for (int i = 0; i < 100; ++i) {
+            wa.addElement(i % 7);
+        }
+        dferone::WelfordAlgorithm last;
+        for (int i = 90; i < 100; ++i) {
+            last.addElement(i % 7);
+        }
+        ASSERT_EQ(wa.getCount(), 10);
+        ASSERT_NEAR(wa.getMean(), last.getMean(), 1e-9);
+        ASSERT_NEAR(wa.getVariance(), last.getVariance(), 1e-9);
+        ASSERT_DOUBLE_EQ(wa.getMin(), 0);
+        ASSERT_DOUBLE_EQ(wa.getMax(), 6);
+
+        ASSERT_THROW(dferone::SlidingWelfordAlgorithm(0), std::runtime_error);
     }
 
     TEST(lik_unl, lik) {
@@ -153,6 +577,27 @@ namespace {
         ASSERT_EQ(mat(0, 0), 0);
         mat(0, 0) = 1;
         ASSERT_EQ(mat(0, 0), 1);
+
+        Matrix<double> padded(3, 5, 2.0, true);
+        ASSERT_EQ(padded.leading_dimension(), 8);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(padded.row(1).data()) % 64, 0);
+        padded(2, 4) = 7.0;
+        auto copy = padded;
+        padded(2, 4) = 1.0;
+        ASSERT_DOUBLE_EQ(copy(2, 4), 7.0);
+        ASSERT_EQ(copy.row(2).size(), 5);
+        ASSERT_DOUBLE_EQ(std::accumulate(copy.row(2).begin(), copy.row(2).end(), 0.0), 15.0);
+
+        auto moved = std::move(copy);
+        ASSERT_DOUBLE_EQ(moved(2, 4), 7.0);
+        ASSERT_EQ(copy.rows(), 0);
+
+        // Shrinking without initializer reuses the buffer
+        const auto *data = moved.data();
+        moved.reset(2, 8, for_overwrite);
+        ASSERT_EQ(moved.data(), data);
+        moved.reset(4, 4, 3.0);
+        ASSERT_DOUBLE_EQ(moved(3, 3), 3.0);
     }
 
     TEST(Mat, sym) {
@@ -160,6 +605,122 @@ namespace {
         ASSERT_EQ(sym_mat(2, 0), 1);
         sym_mat(2, 0) = 3;
         ASSERT_EQ(sym_mat(0, 2), 3);
+        ASSERT_EQ(sym_mat.packed_size(), 6);
+
+        SymmetricMatrix<int, Triangle::Upper> upper(4, for_overwrite);
+        SymmetricMatrix<int> lower(4, for_overwrite);
+        for (std::size_t i = 0; i < 4; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                upper(i, j) = static_cast<int>(10 * j + i);
+                lower(j, i) = static_cast<int>(10 * j + i);
+            }
+        }
+        for (std::size_t i = 0; i < 4; ++i) {
+            for (std::size_t j = 0; j < 4; ++j) {
+                ASSERT_EQ(upper(i, j), upper(j, i));
+                ASSERT_EQ(upper(i, j), lower(i, j));
+            }
+        }
+        // Each element is stored exactly once
+        std::vector<int> packed(upper.data(), upper.data() + upper.packed_size());
+        std::ranges::sort(packed);
+        ASSERT_EQ(std::ranges::adjacent_find(packed), packed.end());
+
+        ASSERT_EQ(upper.packed_row(1).size(), 3);
+        ASSERT_EQ(upper.packed_row(1)[0], upper(1, 1));
+        ASSERT_EQ(upper.packed_row(1)[2], upper(1, 3));
+        ASSERT_EQ(lower.packed_row(2).size(), 3);
+        ASSERT_EQ(lower.packed_row(2)[0], lower(2, 0));
+
+        auto moved = std::move(lower);
+        ASSERT_EQ(moved.rows(), 4);
+        ASSERT_EQ(lower.rows(), 0);
+    }
+
+    TEST(ThreadPool, run) {
+        ThreadPool pool(4);
+        std::vector<int> hits(4, 0);
+        for (int i = 0; i < 100; ++i) {
+            pool.run(1 + i % 4, [&hits](std::uint32_t id) { ++hits[id]; });
+        }
+        ASSERT_EQ(hits, (std::vector<int>{100, 75, 50, 25}));
+        ASSERT_THROW(pool.run(2, [](std::uint32_t) { throw std::runtime_error("job"); }), std::runtime_error);
+        // A job running another job on its own pool would wait for itself forever
+        ASSERT_THROW(pool.run(1, [&pool](std::uint32_t) { pool.run(1, [](std::uint32_t) {}); }), std::runtime_error);
+        std::atomic<int> count{0};
+        pool.run(4, [&count](std::uint32_t) { ++count; });
+        ASSERT_EQ(count, 4);
+    }
+
+    TEST(ThreadPool, task_group) {
+        ThreadPool pool(4);
+        std::atomic<int> count{0};
+        pool.run(2, [&count](std::uint32_t id) {
+            ThreadPool::TaskGroup group;
+            for (int i = 0; i < 100; ++i) {
+                group.run([&count]() { ++count; });
+            }
+            if (id == 1) {
+                group.run([]() { throw std::runtime_error("subtask"); });
+                ASSERT_THROW(group.wait(), std::runtime_error);
+            }
+        });
+        ASSERT_EQ(count, 200);
+
+        // Outside of the pool subtasks are run immediately
+        ThreadPool::TaskGroup group;
+        group.run([&count]() { ++count; });
+        ASSERT_EQ(count, 201);
+    }
+
+    TEST(Mat, mapped) {
+        auto dir = std::filesystem::temp_directory_path();
+        auto dense_path = (dir / "dferone_dense.mat").string();
+        auto sym_path = (dir / "dferone_sym.mat").string();
+
+        Matrix<double> mat(3, 5, 0.0, true);
+        SymmetricMatrix<int, Triangle::Upper> sym(4);
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 5; ++j) {
+                mat(i, j) = static_cast<double>(10 * i + j);
+            }
+        }
+        for (std::size_t i = 0; i < 4; ++i) {
+            for (std::size_t j = i; j < 4; ++j) {
+                sym(i, j) = static_cast<int>(10 * i + j);
+            }
+        }
+        write_matrix(dense_path, mat);
+        write_matrix(sym_path, sym);
+
+        auto mapped = map_matrix<double>(dense_path);
+        ASSERT_EQ(mapped.rows(), 3);
+        ASSERT_EQ(mapped.cols(), 5);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % 64, 0);
+        ASSERT_DOUBLE_EQ(mapped(2, 4), 24.0);
+        ASSERT_DOUBLE_EQ(mapped.row(1)[3], 13.0);
+
+        auto mapped_sym = map_symmetric_matrix<int, Triangle::Upper>(sym_path);
+        ASSERT_EQ(mapped_sym.rows(), 4);
+        ASSERT_EQ(mapped_sym(3, 1), 13);
+        ASSERT_EQ(mapped_sym(1, 3), 13);
+
+        ASSERT_THROW(map_matrix<float>(dense_path), std::runtime_error);
+        ASSERT_THROW(map_symmetric_matrix<int>(sym_path), std::runtime_error);
+        ASSERT_THROW(map_matrix<double>(sym_path), std::runtime_error);
+        ASSERT_THROW(map_matrix<double>((dir / "dferone_missing.mat").string()), std::system_error);
+
+        // Corrupted headers: rows wider than the leading dimension, misaligned elements
+        auto header = detail::make_header<double>(MatrixLayout::Dense, 3, 9, 8);
+        detail::write_file(dense_path, header, mat.data(), 3 * mat.leading_dimension());
+        ASSERT_THROW(map_matrix<double>(dense_path), std::runtime_error);
+        header = detail::make_header<double>(MatrixLayout::Dense, 1, 4, 4);
+        header.payload_offset += 4;
+        detail::write_file(dense_path, header, mat.data(), 3 * mat.leading_dimension());
+        ASSERT_THROW(map_matrix<double>(dense_path), std::runtime_error);
+
+        std::filesystem::remove(dense_path);
+        std::filesystem::remove(sym_path);
     }
 
-} // namespace
\ No newline at end of file
+} // namespace